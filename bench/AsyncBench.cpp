@@ -0,0 +1,149 @@
+// Event-loop throughput with coroutine bookings versus blocking calls, while blocking client
+// threads keep the same shows contended.
+// Each loop handles a stream of events: every fourth is a booking, the rest are ~1us of other work.
+// Blocking mode calls BookSeats inline; async mode spawns a coroutine and keeps handling events,
+// running resumed coroutines from its executor between events.
+
+#include "Async.h"
+#include "BenchUtil.h"
+#include "DataStore.h"
+
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace booking_service;
+using namespace booking_service::bench;
+
+namespace {
+
+constexpr int kTheaters = 4;
+constexpr int kCapacity = 60000;
+constexpr int kContendedSeats = 1000;  // pre-booked; client threads keep retrying them
+constexpr int kClientThreads = 16;
+constexpr int kClientGroupSize = 8;
+constexpr int kLoops = 2;
+constexpr int kEventsPerLoop = 200000;
+constexpr int kBookingEvery = 4;
+
+std::uint64_t DoOtherWork(std::uint64_t seed) {
+    // Roughly a microsecond of CPU work standing in for unrelated event handling
+    for (int i = 0; i < 300; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return seed;
+}
+
+Task<void> BookAsync(DataStore& store, int theaterId, std::string seatId, LoopExecutor& executor, int& outstanding) {
+    const std::vector<std::string> seatIds{std::move(seatId)};
+    co_await store.BookSeatsAsync(theaterId, 1, seatIds, executor);
+    --outstanding;
+}
+
+void Run(const TempDataDir& dir, bool async) {
+    DataStore store;
+    store.LoadData(dir.Path());
+    std::vector<std::string> contended;
+    for (int seat = 1; seat <= kContendedSeats; ++seat) {
+        contended.push_back("a" + std::to_string(seat));
+    }
+    for (int theater = 1; theater <= kTheaters; ++theater) {
+        store.BookSeats(theater, 1, contended);
+    }
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> clients;
+    for (int t = 0; t < kClientThreads; ++t) {
+        clients.emplace_back([&, t]() {
+            std::mt19937 rng(100 + t);
+            std::uniform_int_distribution<int> seatDist(1, kContendedSeats);
+            std::uniform_int_distribution<int> theaterDist(1, kTheaters);
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::vector<std::string> group;
+                for (int i = 0; i < kClientGroupSize; ++i) {
+                    group.push_back("a" + std::to_string(seatDist(rng)));
+                }
+                store.BookSeats(theaterDist(rng), 1, group);
+            }
+        });
+    }
+
+    std::vector<std::vector<std::int64_t>> latencies(kLoops);
+    std::vector<double> seconds(kLoops);
+    std::vector<std::uint64_t> sinks(kLoops);
+    std::vector<std::thread> loops;
+    for (int l = 0; l < kLoops; ++l) {
+        loops.emplace_back([&, l]() {
+            std::mt19937 rng(l);
+            std::uniform_int_distribution<int> seatDist(kContendedSeats + 1, kCapacity);
+            std::uniform_int_distribution<int> theaterDist(1, kTheaters);
+            LoopExecutor executor;
+            int outstanding = 0;
+            std::uint64_t sink = 0;
+            latencies[l].reserve(kEventsPerLoop);
+
+            const auto start = Clock::now();
+            for (int e = 0; e < kEventsPerLoop; ++e) {
+                const auto eventStart = Clock::now();
+                if (e % kBookingEvery == 0) {
+                    const std::string seatId = "a" + std::to_string(seatDist(rng));
+                    if (async) {
+                        ++outstanding;
+                        Spawn(BookAsync(store, theaterDist(rng), seatId, executor, outstanding));
+                    }
+                    else {
+                        store.BookSeats(theaterDist(rng), 1, {seatId});
+                    }
+                }
+                else {
+                    sink = DoOtherWork(sink + e);
+                }
+                executor.RunPending();
+                latencies[l].push_back(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - eventStart).count());
+            }
+            while (outstanding > 0) {
+                executor.RunPending();
+                std::this_thread::yield();
+            }
+            seconds[l] = SecondsSince(start);
+            sinks[l] = sink;
+        });
+    }
+    for (auto& loop : loops) {
+        loop.join();
+    }
+    stop = true;
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    std::vector<std::int64_t> all;
+    double eventsPerSecond = 0;
+    std::uint64_t checksum = 0;
+    for (int l = 0; l < kLoops; ++l) {
+        checksum += sinks[l];
+        all.insert(all.end(), latencies[l].begin(), latencies[l].end());
+        eventsPerSecond += kEventsPerLoop / seconds[l];
+    }
+    std::cout << (async ? "async   " : "blocking") << " loops: " << eventsPerSecond << " events/s (checksum "
+              << checksum << ")\n";
+    PrintLatencies(async ? "  event (async)" : "  event (blocking)", all);
+}
+
+}  // namespace
+
+int main() {
+    TempDataDir dir("async");
+    WriteUniformDataset(dir, 1, kTheaters, kCapacity);
+
+    std::cout << "loops=" << kLoops << " x " << kEventsPerLoop << " events, 1 in " << kBookingEvery
+              << " a booking; " << kClientThreads << " blocking client threads on the same " << kTheaters
+              << " shows\n";
+    Run(dir, false);
+    Run(dir, true);
+    return 0;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace booking_service::bench {
+
+namespace fs = std::filesystem;
+
+using Clock = std::chrono::steady_clock;
+
+inline double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Returns the p-th percentile (0..100) of the samples. Sorts the samples in place.
+ */
+inline std::int64_t Percentile(std::vector<std::int64_t>& samples, double p) {
+    if (samples.empty()) {
+        return 0;
+    }
+    std::ranges::sort(samples);
+    const auto idx = static_cast<std::size_t>(p / 100.0 * static_cast<double>(samples.size() - 1));
+    return samples[idx];
+}
+
+inline void PrintLatencies(const std::string& label, std::vector<std::int64_t>& samplesNs) {
+    const auto p50 = Percentile(samplesNs, 50);
+    const auto p99 = Percentile(samplesNs, 99);
+    const auto p999 = Percentile(samplesNs, 99.9);
+    std::cout << std::left << std::setw(32) << label << " n=" << samplesNs.size() << " p50=" << p50 / 1000.0
+              << "us p99=" << p99 / 1000.0 << "us p999=" << p999 / 1000.0 << "us\n";
+}
+
+/**
+ * @brief Resident set size of the current process in bytes (Linux only, 0 elsewhere).
+ */
+inline std::size_t ResidentBytes() {
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmRSS:") {
+            std::size_t kb = 0;
+            status >> kb;
+            return kb * 1024;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Synthetic data directory with movies.json, theaters.json and mappings.json.
+ *
+ * The directory is removed when the object goes out of scope.
+ */
+class TempDataDir {
+public:
+    explicit TempDataDir(const std::string& name)
+        : path(fs::temp_directory_path() / ("booking_bench_" + name)) {
+        fs::remove_all(path);
+        fs::create_directories(path);
+    }
+
+    ~TempDataDir() {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+
+    TempDataDir(const TempDataDir&) = delete;
+    TempDataDir& operator=(const TempDataDir&) = delete;
+
+    void Write(const std::string& file, const nlohmann::json& content) const {
+        std::ofstream out(path / file);
+        out << content;
+    }
+
+    const fs::path& Path() const { return path; }
+
+private:
+    fs::path path;
+};
+
+/**
+ * @brief Writes `movies` movies and `theaters` theaters of `capacity` seats, every movie shown in every theater.
+ *
+ * Theaters are split into priced standard and vip classes unless `priced` is false, in which case they use
+ * the unpriced single-class layout.
+ */
+inline void WriteUniformDataset(const TempDataDir& dir, int movies, int theaters, int capacity, bool priced = true) {
+    nlohmann::json moviesJson = nlohmann::json::array();
+    for (int i = 1; i <= movies; ++i) {
+        moviesJson.push_back({{"id", i}, {"title", "Movie " + std::to_string(i)}});
+    }
+
+    nlohmann::json theatersJson = nlohmann::json::array();
+    for (int i = 1; i <= theaters; ++i) {
+        nlohmann::json theater = {{"id", i}, {"name", "Theater " + std::to_string(i)}, {"capacity", capacity}};
+        if (priced) {
+            theater["seatClasses"] = {{{"name", "standard"}, {"seats", capacity - capacity / 4}, {"price", 12000}},
+                                      {{"name", "vip"}, {"seats", capacity / 4}, {"price", 20000}}};
+        }
+        theatersJson.push_back(std::move(theater));
+    }
+
+    nlohmann::json mappingsJson = nlohmann::json::object();
+    for (int m = 1; m <= movies; ++m) {
+        auto& tids = mappingsJson[std::to_string(m)] = nlohmann::json::array();
+        for (int t = 1; t <= theaters; ++t) {
+            tids.push_back(t);
+        }
+    }
+
+    dir.Write("movies.json", moviesJson);
+    dir.Write("theaters.json", theatersJson);
+    dir.Write("mappings.json", mappingsJson);
+}
+
+inline const std::chrono::sys_seconds kYearStart = std::chrono::sys_days{std::chrono::year{2026} / 1 / 1};
+inline constexpr std::chrono::minutes kScheduleSlots[] = {std::chrono::hours{10},
+                                                          std::chrono::hours{12} + std::chrono::minutes{30},
+                                                          std::chrono::hours{15},
+                                                          std::chrono::hours{17} + std::chrono::minutes{30},
+                                                          std::chrono::hours{20},
+                                                          std::chrono::hours{22} + std::chrono::minutes{30}};
+
+/**
+ * @brief Writes a uniform dataset where every theater runs one screening per daily slot for `days` days,
+ * each showing a random movie.
+ */
+inline void WriteYearSchedule(const TempDataDir& dir, int movies, int theaters, int capacity, int days) {
+    WriteUniformDataset(dir, movies, theaters, capacity);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> movieDist(1, movies);
+    std::map<std::pair<int, int>, nlohmann::json> showtimes;
+    for (int theater = 1; theater <= theaters; ++theater) {
+        for (int day = 0; day < days; ++day) {
+            for (const auto slot : kScheduleSlots) {
+                const auto start = kYearStart + std::chrono::days{day} + slot;
+                showtimes[{movieDist(rng), theater}].push_back(start.time_since_epoch().count());
+            }
+        }
+    }
+
+    nlohmann::json mappings = nlohmann::json::object();
+    for (auto& [key, times] : showtimes) {
+        mappings[std::to_string(key.first)].push_back({{"theaterId", key.second}, {"showtimes", std::move(times)}});
+    }
+    dir.Write("mappings.json", mappings);
+}
+
+}  // namespace booking_service::bench
@@ -0,0 +1,97 @@
+// Booking throughput of unpriced theaters without a pricing policy (the layout before seat classes),
+// static seat-class prices and a dynamic pricing policy.
+// Every seat of every show is booked exactly once, spread across threads; all threads walk the shows
+// in the same order, so any work added under the show lock shows up as contention.
+
+#include "BenchUtil.h"
+#include "DataStore.h"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace booking_service;
+using namespace booking_service::bench;
+
+namespace {
+
+constexpr int kMovies = 8;
+constexpr int kTheaters = 8;
+constexpr int kCapacity = 400;
+constexpr int kRounds = 5;
+
+enum class Pricing { Baseline, Static, Dynamic };
+
+const char* PricingName(Pricing pricing) {
+    switch (pricing) {
+    case Pricing::Baseline:
+        return "baseline";
+    case Pricing::Static:
+        return "static  ";
+    case Pricing::Dynamic:
+        return "dynamic ";
+    }
+    return "";
+}
+
+double RunRound(const TempDataDir& dir, int threads, Pricing pricing) {
+    DataStore store;
+    store.LoadData(dir.Path());
+    if (pricing == Pricing::Dynamic) {
+        store.SetPricingPolicy([](std::int64_t basePrice, const PricingContext& context) {
+            return context.bookedSeats * 4 >= context.capacity * 3 ? basePrice * 5 / 4 : basePrice;
+        });
+    }
+
+    std::atomic<std::int64_t> booked{0};
+    std::vector<std::thread> workers;
+    const auto start = Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            std::int64_t local = 0;
+            for (int seat = t + 1; seat <= kCapacity; seat += threads) {
+                const std::vector<std::string> seatIds{"a" + std::to_string(seat)};
+                for (int m = 1; m <= kMovies; ++m) {
+                    for (int th = 1; th <= kTheaters; ++th) {
+                        local += static_cast<bool>(store.BookSeats(th, m, seatIds));
+                    }
+                }
+            }
+            booked += local;
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    const double elapsed = SecondsSince(start);
+
+    if (booked.load() != static_cast<std::int64_t>(kMovies) * kTheaters * kCapacity) {
+        std::cerr << "Unexpected booking count " << booked.load() << '\n';
+    }
+    return static_cast<double>(kMovies) * kTheaters * kCapacity / elapsed;
+}
+
+}  // namespace
+
+int main() {
+    TempDataDir pricedDir("booking");
+    WriteUniformDataset(pricedDir, kMovies, kTheaters, kCapacity);
+    TempDataDir unpricedDir("booking_unpriced");
+    WriteUniformDataset(unpricedDir, kMovies, kTheaters, kCapacity, false);
+
+    const int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        for (const auto pricing : {Pricing::Baseline, Pricing::Static, Pricing::Dynamic}) {
+            const auto& dir = pricing == Pricing::Baseline ? unpricedDir : pricedDir;
+            double best = 0;
+            for (int round = 0; round < kRounds; ++round) {
+                best = std::max(best, RunRound(dir, threads, pricing));
+            }
+            std::cout << "threads=" << threads << ' ' << PricingName(pricing) << " pricing: " << best
+                      << " bookings/s\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Flash sale: many threads hammer one hot show while a few threads keep booking other shows.
+// Every hot seat is requested twice, so half of the attempts before the sell-out conflict and every
+// attempt after it is answered "sold out".
+// Reports hot-show and background latencies with plain show locking versus the admission queue.
+
+#include "BenchUtil.h"
+#include "DataStore.h"
+
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace booking_service;
+using namespace booking_service::bench;
+
+namespace {
+
+constexpr int kMovies = 4;
+constexpr int kTheaters = 8;
+constexpr int kCapacity = 2000;
+constexpr int kHotThreads = 64;
+constexpr int kHotAttempts = 200;
+constexpr int kBackgroundThreads = 4;
+constexpr int kBackgroundBookings = 5000;
+
+struct Samples {
+    std::vector<std::int64_t> hot;
+    std::vector<std::int64_t> background;
+    std::array<std::atomic<int>, 4> outcomes{};  // indexed by BookingStatus
+};
+
+void Run(const TempDataDir& dir, const std::string& label, AdmissionPolicy policy) {
+    DataStore store;
+    store.LoadData(dir.Path());
+    store.SetAdmissionPolicy(policy);
+
+    Samples samples;
+    std::vector<std::vector<std::int64_t>> perThread(kHotThreads + kBackgroundThreads);
+    std::atomic<int> hotTickets{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < kHotThreads + kBackgroundThreads; ++t) {
+        workers.emplace_back([&, t]() {
+            const bool hot = t < kHotThreads;
+            std::mt19937 rng(t);
+            std::uniform_int_distribution<int> seatDist(1, kCapacity);
+            std::uniform_int_distribution<int> movieDist(1, kMovies);
+            std::uniform_int_distribution<int> theaterDist(2, kTheaters);
+            auto& latencies = perThread[t];
+            latencies.reserve(hot ? kHotAttempts : kBackgroundBookings);
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+
+            for (int i = 0; i < (hot ? kHotAttempts : kBackgroundBookings); ++i) {
+                const int seat = hot ? hotTickets.fetch_add(1) / 2 % kCapacity + 1 : seatDist(rng);
+                const std::vector<std::string> seatIds{"a" + std::to_string(seat)};
+                const int theaterId = hot ? 1 : theaterDist(rng);
+                const int movieId = hot ? 1 : movieDist(rng);
+                const auto start = Clock::now();
+                const auto result = store.BookSeats(theaterId, movieId, seatIds);
+                latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+                if (hot) {
+                    ++samples.outcomes[static_cast<std::size_t>(result.status)];
+                }
+            }
+        });
+    }
+
+    const auto start = Clock::now();
+    go = true;
+    for (auto& w : workers) {
+        w.join();
+    }
+    const double elapsed = SecondsSince(start);
+
+    for (int t = 0; t < kHotThreads + kBackgroundThreads; ++t) {
+        auto& target = t < kHotThreads ? samples.hot : samples.background;
+        target.insert(target.end(), perThread[t].begin(), perThread[t].end());
+    }
+
+    std::cout << label << ": " << elapsed * 1000 << "ms, hot show booked=" << samples.outcomes[0]
+              << " rejected=" << samples.outcomes[1] << " soldOut=" << samples.outcomes[2]
+              << " overloaded=" << samples.outcomes[3] << '\n';
+    PrintLatencies("  hot show", samples.hot);
+    PrintLatencies("  background shows", samples.background);
+}
+
+}  // namespace
+
+int main() {
+    TempDataDir dir("flash_sale");
+    WriteUniformDataset(dir, kMovies, kTheaters, kCapacity);
+
+    std::cout << "hot threads=" << kHotThreads << " x " << kHotAttempts << " attempts on " << kCapacity
+              << " seats, background threads=" << kBackgroundThreads << " x " << kBackgroundBookings << '\n';
+    Run(dir, "show lock", AdmissionPolicy{.combineBookings = false});
+    Run(dir, "admission queue (256)", AdmissionPolicy{true, 256});
+    Run(dir, "admission queue (16)", AdmissionPolicy{true, 16});
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Memory footprint and time-range query latency for a year of screenings.
+
+#include "BenchUtil.h"
+#include "DataStore.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace booking_service;
+using namespace booking_service::bench;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr int kMovies = 200;
+constexpr int kTheaters = 100;
+constexpr int kCapacity = 150;
+constexpr int kDays = 365;
+constexpr int kQueries = 100000;
+constexpr int kScanQueries = 100;
+
+}  // namespace
+
+int main() {
+    TempDataDir dir("schedule");
+    WriteYearSchedule(dir, kMovies, kTheaters, kCapacity, kDays);
+
+    const auto rssBefore = ResidentBytes();
+    DataStore store;
+    auto start = Clock::now();
+    store.LoadData(dir.Path());
+    const double loadSeconds = SecondsSince(start);
+    const auto rssAfter = ResidentBytes();
+
+    const int screenings = kTheaters * kDays * static_cast<int>(std::size(kScheduleSlots));
+    const auto rssDelta = rssAfter - rssBefore;
+    std::cout << "screenings=" << screenings << " load=" << loadSeconds << "s rss=" << rssDelta / 1048576.0 << "MiB ("
+              << rssDelta / screenings << " bytes/screening)\n";
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> movieDist(1, kMovies);
+    std::uniform_int_distribution<int> theaterDist(1, kTheaters);
+    std::uniform_int_distribution<long> offsetDist(0, std::chrono::seconds{std::chrono::days{kDays}}.count());
+
+    std::size_t found = 0;
+    start = Clock::now();
+    for (int i = 0; i < kQueries; ++i) {
+        const auto from = kYearStart + std::chrono::seconds{offsetDist(rng)};
+        found += store.GetScreenings(movieDist(rng), from, from + 3h).size();
+    }
+    std::cout << "movie next-3h query:      " << SecondsSince(start) / kQueries * 1e9 << " ns/query (avg "
+              << static_cast<double>(found) / kQueries << " results)\n";
+
+    found = 0;
+    start = Clock::now();
+    for (int i = 0; i < kQueries; ++i) {
+        const auto from = kYearStart + std::chrono::seconds{offsetDist(rng)};
+        found += store.GetTheaterScreenings(theaterDist(rng), from, from + 24h).size();
+    }
+    std::cout << "theater next-24h query:   " << SecondsSince(start) / kQueries * 1e9 << " ns/query (avg "
+              << static_cast<double>(found) / kQueries << " results)\n";
+
+    // Reference: the same movie query answered by scanning every screening
+    found = 0;
+    start = Clock::now();
+    for (int i = 0; i < kScanQueries; ++i) {
+        const int movieId = movieDist(rng);
+        const auto from = kYearStart + std::chrono::seconds{offsetDist(rng)};
+        for (int id = 0; id < screenings; ++id) {
+            const auto screening = store.GetScreening(id);
+            if (screening->movieId == movieId && screening->startTime >= from && screening->startTime < from + 3h) {
+                ++found;
+            }
+        }
+    }
+    std::cout << "movie next-3h full scan:  " << SecondsSince(start) / kScanQueries * 1e9 << " ns/query\n";
+    return 0;
+}
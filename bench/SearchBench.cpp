@@ -0,0 +1,147 @@
+// Search index build time, memory and per-query latency over 100k synthetic titles, queried on the
+// bare SearchIndex and through BookingService::SearchMovies/SearchTheaters on a loaded DataStore.
+
+#include "BenchUtil.h"
+#include "BookingService.h"
+#include "DataStore.h"
+#include "SearchIndex.h"
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace booking_service;
+using namespace booking_service::bench;
+
+namespace {
+
+constexpr int kTitles = 100000;
+constexpr int kTheaters = 10000;
+constexpr int kQueriesPerKind = 20000;
+
+const std::vector<std::string> kWords = {
+    "the",     "matrix",    "return",  "dark",   "knight", "star",      "wars",    "empire", "inception",
+    "amélie",  "zhovten",   "cinema",  "lord",   "rings",  "king",      "lion",    "night",  "city",
+    "blade",   "runner",    "godfather", "part", "interstellar", "tenet", "dune",  "planet", "odyssey",
+    "space",   "crème",     "brûlée",  "señor",  "jalapeño", "kyiv",    "Київ",    "ніч",    "зоря",
+    "love",    "story",     "war",     "peace",  "alien",  "predator",  "memento", "prestige", "heat",
+};
+
+const std::vector<std::string> kSyllables = {"ka", "lo", "mi", "ne", "ru", "sta", "vor", "ze", "bri", "dan",
+                                              "fel", "gor", "hu", "ix", "jo", "qua", "pel", "tin", "wu", "yel"};
+
+// A third of the words come from the common list above, the rest are synthetic 2-3 syllable words
+std::string RandomWord(std::mt19937& rng) {
+    if (rng() % 3 == 0) {
+        return kWords[rng() % kWords.size()];
+    }
+    std::string word;
+    const auto syllables = 2 + rng() % 2;
+    for (std::size_t i = 0; i < syllables; ++i) {
+        word += kSyllables[rng() % kSyllables.size()];
+    }
+    return word;
+}
+
+std::string RandomTitle(std::mt19937& rng) {
+    std::uniform_int_distribution<int> lengthDist(1, 5);
+    std::string title;
+    const int words = lengthDist(rng);
+    for (int i = 0; i < words; ++i) {
+        if (i > 0) {
+            title += ' ';
+        }
+        title += RandomWord(rng);
+    }
+    return title + " " + std::to_string(rng() % 1000);
+}
+
+template <class Search>
+void RunQueries(const std::string& label, const std::vector<std::string>& queries, Search search) {
+    std::vector<std::int64_t> samples;
+    samples.reserve(queries.size());
+    std::size_t results = 0;
+    for (const auto& query : queries) {
+        const auto start = Clock::now();
+        results += search(query).size();
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    PrintLatencies(label, samples);
+    if (results == 0) {
+        std::cerr << "No results for " << label << "\n";
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    std::vector<std::string> titles;
+    titles.reserve(kTitles);
+    for (int i = 0; i < kTitles; ++i) {
+        titles.push_back(RandomTitle(rng));
+    }
+
+    const auto rssBefore = ResidentBytes();
+    const auto start = Clock::now();
+    SearchIndex index;
+    for (int i = 0; i < kTitles; ++i) {
+        index.Add(i + 1, titles[i]);
+    }
+    index.Build();
+    std::cout << "titles=" << kTitles << " build=" << SecondsSince(start)
+              << "s rss=" << (ResidentBytes() - rssBefore) / 1048576.0 << "MiB\n";
+
+    // Queries are typed prefixes of words picked from random titles
+    std::uniform_int_distribution<std::size_t> titleDist(0, titles.size() - 1);
+    std::vector<std::string> oneChar, threeChars, fullWord, twoWords;
+    for (int i = 0; i < kQueriesPerKind; ++i) {
+        const std::string& title = titles[titleDist(rng)];
+        const std::string word = title.substr(0, title.find(' '));
+        const std::string next = title.substr(word.size() + 1);
+        oneChar.push_back(word.substr(0, 1));
+        threeChars.push_back(word.substr(0, 3));
+        fullWord.push_back(word);
+        twoWords.push_back(word + " " + next.substr(0, 3));
+    }
+
+    const auto searchIndex = [&index](const std::string& query) { return index.Search(query, 10); };
+    RunQueries("index 1-char prefix", oneChar, searchIndex);
+    RunQueries("index 3-char prefix", threeChars, searchIndex);
+    RunQueries("index full word", fullWord, searchIndex);
+    RunQueries("index word + 3-char prefix", twoWords, searchIndex);
+
+    // The same titles as movies, and the first kTheaters of them as theater names, loaded into a store
+    TempDataDir dir("search");
+    nlohmann::json moviesJson = nlohmann::json::array();
+    nlohmann::json theatersJson = nlohmann::json::array();
+    for (int i = 0; i < kTitles; ++i) {
+        moviesJson.push_back({{"id", i + 1}, {"title", titles[i]}});
+        if (i < kTheaters) {
+            theatersJson.push_back({{"id", i + 1}, {"name", titles[i]}, {"capacity", 1}});
+        }
+    }
+    dir.Write("movies.json", moviesJson);
+    dir.Write("theaters.json", theatersJson);
+    dir.Write("mappings.json", nlohmann::json::object());
+
+    auto store = std::make_shared<DataStore>();
+    const auto loadStart = Clock::now();
+    store->LoadData(dir.Path());
+    std::cout << "store load with " << kTitles << " movies and " << kTheaters
+              << " theaters: " << SecondsSince(loadStart) << "s\n";
+    const BookingService service(store);
+
+    const auto searchMovies = [&service](const std::string& query) { return service.SearchMovies(query, 10); };
+    RunQueries("service movies 1-char prefix", oneChar, searchMovies);
+    RunQueries("service movies 3-char prefix", threeChars, searchMovies);
+    RunQueries("service movies full word", fullWord, searchMovies);
+    RunQueries("service movies word + 3-char", twoWords, searchMovies);
+
+    const auto searchTheaters = [&service](const std::string& query) { return service.SearchTheaters(query, 10); };
+    RunQueries("service theaters 3-char prefix", threeChars, searchTheaters);
+    RunQueries("service theaters full word", fullWord, searchTheaters);
+    return 0;
+}
@@ -0,0 +1,214 @@
+// Seat-state backends per venue size class versus the layouts they replace: the original
+// std::vector<Seat> per show (a string id and a flag per seat) and the flat heap bitmap shows held
+// just before the backends were split by size.
+// For each class: bytes per show, ns per seat to check-and-book a whole show, and ns per
+// "find 4 free seats" query on a show that is 99.9% sold. Seats are addressed by index in all
+// three; the original layout also looked each seat id up with a linear scan, which is not counted.
+// Against the flat bitmap, the hierarchical backend pays for its summary words with a few more
+// bytes and a slower Book; what it buys is the find-free query on nearly sold-out venues.
+
+#include "BenchUtil.h"
+#include "Models.h"
+#include "SeatStore.h"
+
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace booking_service;
+using namespace booking_service::bench;
+
+namespace {
+
+constexpr std::uint32_t kCapacities[] = {48, 200, 2000, 60000};
+constexpr std::size_t kSeatsPerRound = 4000000;
+constexpr std::size_t kSeatsPerChunk = 65536;  // shows are built a chunk at a time, outside the timing
+constexpr std::size_t kQueries = 100000;
+constexpr std::size_t kFreeSeatsRequested = 4;
+
+/**
+ * Bytes taken by a heap block of `size` bytes with glibc malloc (8-byte header, 16-byte granularity, 32 minimum).
+ */
+std::size_t HeapBytes(std::size_t size) {
+    return std::max<std::size_t>(32, (size + 8 + 15) / 16 * 16);
+}
+
+/**
+ * Layout before the size-specialized backends: one heap-allocated word vector per show, scanned linearly.
+ */
+class FlatSeatStore {
+public:
+    explicit FlatSeatStore(std::uint32_t capacity)
+        : words(SeatWordCount(capacity), 0)
+        , capacity(capacity) {
+    }
+
+    bool IsBooked(std::uint32_t seat) const { return (words[seat / kSeatsPerWord] >> (seat % kSeatsPerWord)) & 1; }
+    void Book(std::uint32_t seat) { words[seat / kSeatsPerWord] |= std::uint64_t{1} << (seat % kSeatsPerWord); }
+
+    void FindFree(std::size_t count, std::vector<std::uint32_t>& out) const {
+        for (std::size_t w = 0; w < words.size() && out.size() < count; ++w) {
+            detail::CollectFreeSeats(words[w], w, capacity, count, out);
+        }
+    }
+
+    std::size_t Bytes() const { return sizeof(*this) + HeapBytes(words.capacity() * sizeof(std::uint64_t)); }
+
+private:
+    std::vector<std::uint64_t> words;
+    std::uint32_t capacity;
+};
+
+/**
+ * Original layout: the show's own copy of the theater's seats, booked through their flags.
+ */
+class SeatVectorStore {
+public:
+    explicit SeatVectorStore(const std::vector<Seat>& layout)
+        : seats(layout) {
+    }
+
+    bool IsBooked(std::uint32_t seat) const { return seats[seat].isBooked; }
+    void Book(std::uint32_t seat) { seats[seat].isBooked = true; }
+
+    void FindFree(std::size_t count, std::vector<std::uint32_t>& out) const {
+        for (std::uint32_t seat = 0; seat < seats.size() && out.size() < count; ++seat) {
+            if (!seats[seat].isBooked) {
+                out.push_back(seat);
+            }
+        }
+    }
+
+    std::size_t Bytes() const {
+        std::size_t bytes = sizeof(*this) + HeapBytes(seats.capacity() * sizeof(Seat));
+        for (const auto& seat : seats) {
+            if (seat.id.capacity() > std::string().capacity()) {
+                bytes += HeapBytes(seat.id.capacity() + 1);
+            }
+        }
+        return bytes;
+    }
+
+private:
+    std::vector<Seat> seats;
+};
+
+std::size_t Bytes(const SeatState& state) {
+    if (const auto* store = std::get_if<HierarchicalSeatStore>(&state)) {
+        const auto words = store->Bitmap().size();
+        return sizeof(SeatState) + HeapBytes((words + SeatWordCount(words)) * sizeof(std::uint64_t));
+    }
+    return sizeof(SeatState);
+}
+
+// The variant is dispatched once per call, as DataStore does
+template <class Fn>
+decltype(auto) Visit(SeatState& state, Fn&& fn) {
+    return std::visit(std::forward<Fn>(fn), state);
+}
+
+template <class Store, class Fn>
+decltype(auto) Visit(Store& store, Fn&& fn) {
+    return fn(store);
+}
+
+template <class MakeStore>
+double BookAllNs(std::uint32_t capacity, const std::vector<std::uint32_t>& order, MakeStore makeStore) {
+    const std::size_t shows = std::max<std::size_t>(1, kSeatsPerRound / capacity);
+    const std::size_t showsPerChunk = std::max<std::size_t>(1, kSeatsPerChunk / capacity);
+    std::size_t booked = 0;
+    double seconds = 0;
+    for (std::size_t first = 0; first < shows; first += showsPerChunk) {
+        std::vector<decltype(makeStore())> chunk;
+        for (std::size_t s = first; s < std::min(shows, first + showsPerChunk); ++s) {
+            chunk.push_back(makeStore());
+        }
+        const auto start = Clock::now();
+        for (auto& state : chunk) {
+            booked += Visit(state, [&order](auto& store) {
+                std::size_t count = 0;
+                for (const auto seat : order) {
+                    if (!store.IsBooked(seat)) {
+                        store.Book(seat);
+                        ++count;
+                    }
+                }
+                return count;
+            });
+        }
+        seconds += SecondsSince(start);
+    }
+    const double ns = seconds * 1e9 / static_cast<double>(shows * capacity);
+    if (booked != shows * capacity) {
+        std::cerr << "Unexpected booking count\n";
+    }
+    return ns;
+}
+
+template <class State>
+double FindFreeNs(State& state) {
+    std::vector<std::uint32_t> out;
+    std::size_t found = 0;
+    const auto start = Clock::now();
+    for (std::size_t q = 0; q < kQueries; ++q) {
+        out.clear();
+        Visit(state, [&out](const auto& store) { store.FindFree(kFreeSeatsRequested, out); });
+        found += out.size();
+    }
+    const double ns = SecondsSince(start) * 1e9 / kQueries;
+    if (found == 0) {
+        std::cerr << "No free seats found\n";
+    }
+    return ns;
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937 rng(3);
+    for (const auto capacity : kCapacities) {
+        std::vector<std::uint32_t> order(capacity);
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::shuffle(order, rng);
+
+        std::vector<Seat> layout(capacity);
+        for (std::uint32_t seat = 0; seat < capacity; ++seat) {
+            layout[seat].id = "a" + std::to_string(seat + 1);
+        }
+        const auto makeSpecialized = [capacity]() { return MakeSeatState(capacity); };
+        const auto makeFlat = [capacity]() { return FlatSeatStore(capacity); };
+        const auto makeSeatVector = [&layout]() { return SeatVectorStore(layout); };
+
+        const double specializedBookNs = BookAllNs(capacity, order, makeSpecialized);
+        const double flatBookNs = BookAllNs(capacity, order, makeFlat);
+        const double seatVectorBookNs = BookAllNs(capacity, order, makeSeatVector);
+
+        // Leave 0.1% of the seats (at least one) free, scattered across the hall
+        const std::size_t freeSeats = std::max<std::size_t>(1, capacity / 1000);
+        SeatState specialized = makeSpecialized();
+        FlatSeatStore flat = makeFlat();
+        SeatVectorStore seatVector = makeSeatVector();
+        for (std::size_t i = freeSeats; i < order.size(); ++i) {
+            Visit(specialized, [seat = order[i]](auto& store) { store.Book(seat); });
+            flat.Book(order[i]);
+            seatVector.Book(order[i]);
+        }
+        const double specializedFindNs = FindFreeNs(specialized);
+        const double flatFindNs = FindFreeNs(flat);
+        const double seatVectorFindNs = FindFreeNs(seatVector);
+
+        const char* backend = std::holds_alternative<FixedSeatStore<1>>(specialized)   ? "single word"
+                              : std::holds_alternative<FixedSeatStore<4>>(specialized) ? "inline array"
+                                                                                       : "hierarchical";
+        std::cout << "capacity=" << capacity << " (" << backend << ")\n"
+                  << "  bytes/show:      specialized=" << Bytes(specialized) << " flat=" << flat.Bytes()
+                  << " seat vector=" << seatVector.Bytes() << '\n'
+                  << "  book ns/seat:    specialized=" << specializedBookNs << " flat=" << flatBookNs
+                  << " seat vector=" << seatVectorBookNs << '\n'
+                  << "  find-free ns:    specialized=" << specializedFindNs << " flat=" << flatFindNs
+                  << " seat vector=" << seatVectorFindNs << '\n';
+    }
+    return 0;
+}
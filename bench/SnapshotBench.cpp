@@ -0,0 +1,88 @@
+// Snapshot export/import throughput and booking latency while an export is running.
+
+#include "BenchUtil.h"
+#include "DataStore.h"
+
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace booking_service;
+using namespace booking_service::bench;
+
+namespace {
+
+constexpr int kMovies = 200;
+constexpr int kTheaters = 100;
+constexpr int kCapacity = 400;
+constexpr int kDays = 365;
+constexpr int kRounds = 3;
+constexpr int kLatencySamples = 200000;
+
+/**
+ * Books random single seats and records per-call latency until `samples` calls were made.
+ */
+std::vector<std::int64_t> MeasureBookings(DataStore& store, int screenings, int samples, std::mt19937& rng) {
+    std::uniform_int_distribution<int> screeningDist(0, screenings - 1);
+    std::uniform_int_distribution<int> seatDist(1, kCapacity);
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(samples);
+    for (int i = 0; i < samples; ++i) {
+        const std::vector<std::string> seatIds{"a" + std::to_string(seatDist(rng))};
+        const int screeningId = screeningDist(rng);
+        const auto start = Clock::now();
+        store.BookSeats(screeningId, seatIds);
+        latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    return latencies;
+}
+
+}  // namespace
+
+int main() {
+    TempDataDir dir("snapshot");
+    WriteYearSchedule(dir, kMovies, kTheaters, kCapacity, kDays);
+
+    DataStore store;
+    store.LoadData(dir.Path());
+    const int screenings = kTheaters * kDays * static_cast<int>(std::size(kScheduleSlots));
+
+    std::mt19937 rng(42);
+    // Leave a realistic share of seats booked before exporting
+    MeasureBookings(store, screenings, screenings * 10, rng);
+
+    const auto snapshot = dir.Path() / "store.snapshot";
+    double exportSeconds = 1e9;
+    double importSeconds = 1e9;
+    for (int round = 0; round < kRounds; ++round) {
+        auto start = Clock::now();
+        store.ExportSnapshot(snapshot);
+        exportSeconds = std::min(exportSeconds, SecondsSince(start));
+
+        DataStore replica;
+        start = Clock::now();
+        replica.ImportSnapshot(snapshot);
+        importSeconds = std::min(importSeconds, SecondsSince(start));
+    }
+    const double megabytes = static_cast<double>(fs::file_size(snapshot)) / 1048576.0;
+    std::cout << "screenings=" << screenings << " snapshot=" << megabytes << "MiB\n";
+    std::cout << "export: " << exportSeconds << "s (" << megabytes / exportSeconds << " MiB/s)\n";
+    std::cout << "import: " << importSeconds << "s (" << megabytes / importSeconds << " MiB/s)\n";
+
+    auto idle = MeasureBookings(store, screenings, kLatencySamples, rng);
+    PrintLatencies("booking, no export", idle);
+
+    std::atomic<bool> stop{false};
+    std::thread exporter([&]() {
+        while (!stop.load()) {
+            store.ExportSnapshot(snapshot);
+        }
+    });
+    auto during = MeasureBookings(store, screenings, kLatencySamples, rng);
+    stop = true;
+    exporter.join();
+    PrintLatencies("booking, during export", during);
+    return 0;
+}
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <iomanip>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -49,11 +50,24 @@ void PrintSeats(const std::vector<Seat>& seats) {
 
 }  // namespace
 
-int main() {
+int main(int argc, char** argv) {
+    // `movie_cli --record <file>` saves the session's seat reads and bookings for booking_replay
+    const bool record = argc == 3 && std::string_view(argv[1]) == "--record";
+    if (argc > 1 && !record) {
+        std::cerr << "Usage: " << argv[0] << " [--record <trace file>]\n";
+        return 2;
+    }
+
     auto store = std::make_shared<DataStore>();
     store->LoadData(kPathData);
     BookingService service(store);
 
+    std::shared_ptr<TraceRecorder> recorder;
+    if (record) {
+        recorder = std::make_shared<TraceRecorder>();
+        service.SetTraceRecorder(recorder);
+    }
+
     std::cout << "Welcome to Movie Booking Service CLI\n";
 
     while (true) {
@@ -152,8 +166,15 @@ int main() {
                 continue;
             }
 
-            if (service.BookSeats(theaterId, movieId, seatsToBook)) {
-                std::cout << "Booking SUCCESSFUL!\n";
+            if (auto result = service.BookSeats(theaterId, movieId, seatsToBook)) {
+                std::cout << "Booking SUCCESSFUL! Total price: " << result.totalPrice / 100 << "." << std::setw(2)
+                          << std::setfill('0') << result.totalPrice % 100 << "\n";
+            }
+            else if (result.status == BookingStatus::SoldOut) {
+                std::cout << "Booking FAILED! The show is sold out.\n";
+            }
+            else if (result.status == BookingStatus::Overloaded) {
+                std::cout << "Booking FAILED! Too many bookings in progress, please try again.\n";
             }
             else {
                 std::cout << "Booking FAILED! Some seats might be already booked or "
@@ -162,5 +183,15 @@ int main() {
         }
     }
 
+    if (recorder) {
+        try {
+            SaveTrace(argv[2], recorder->Events());
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        std::cout << "Trace saved to " << argv[2] << "\n";
+    }
     return 0;
 }
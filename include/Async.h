@@ -0,0 +1,195 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace booking_service {
+
+/**
+ * @brief Runs work handed over by the store, such as resuming a suspended coroutine.
+ *
+ * Post may be called from any thread, including from work the executor is running.
+ * Implementations must queue the work rather than run it inside Post.
+ * The store posts nothing but resumptions, and requests are applied whether or not the executor runs.
+ */
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    virtual void Post(std::function<void()> work) = 0;
+};
+
+/**
+ * @brief Executor drained by an event loop: Post queues work, RunPending runs it on the calling thread.
+ *
+ * Work still queued when the executor is destroyed is run by the destructor, so coroutines waiting
+ * to be resumed on it finish instead of leaking. Requests still queued in a show at that point
+ * would resume on a destroyed executor: wait for them (or destroy their coroutines) first.
+ */
+class LoopExecutor : public Executor {
+public:
+    LoopExecutor() = default;
+    LoopExecutor(const LoopExecutor&) = delete;
+    LoopExecutor& operator=(const LoopExecutor&) = delete;
+    ~LoopExecutor() override;
+
+    void Post(std::function<void()> work) override;
+
+    /**
+     * @brief Runs the work queued before the call; work posted meanwhile waits for the next call.
+     *
+     * @return Number of work items run.
+     */
+    std::size_t RunPending();
+
+private:
+    std::mutex mtx;
+    std::vector<std::function<void()>> pending;
+    std::vector<std::function<void()>> running;
+};
+
+template <class T>
+class Task;
+
+namespace detail {
+
+template <class T>
+struct TaskPromiseBase {
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            auto continuation = handle.promise().continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() { error = std::current_exception(); }
+
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+};
+
+template <class T>
+struct TaskPromise : TaskPromiseBase<T> {
+    Task<T> get_return_object();
+    void return_value(T result) { value = std::move(result); }
+
+    T Result() {
+        if (this->error) {
+            std::rethrow_exception(this->error);
+        }
+        return std::move(*value);
+    }
+
+    std::optional<T> value;
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase<void> {
+    Task<void> get_return_object();
+    void return_void() const noexcept {}
+
+    void Result() const {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a T.
+ *
+ * The body runs when the task is co_awaited and resumes the awaiting coroutine when it finishes.
+ * Exceptions thrown by the body are rethrown from co_await. Use Spawn to start a task from
+ * non-coroutine code.
+ */
+template <class T = void>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle)
+        : handle(handle) {
+    }
+
+    Task(Task&& other) noexcept
+        : handle(std::exchange(other.handle, {})) {
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task& operator=(Task&&) = delete;
+
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() { return handle.promise().Result(); }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace detail {
+
+template <class T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief Coroutine that starts immediately and frees itself when it finishes.
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+inline DetachedTask RunDetached(Task<void> task) {
+    co_await task;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Starts a task on the calling thread without waiting for it.
+ *
+ * The task runs until its first suspension before Spawn returns; after that it continues wherever
+ * it is resumed. An exception escaping the task terminates the program.
+ */
+inline void Spawn(Task<void> task) {
+    detail::RunDetached(std::move(task));
+}
+
+}  // namespace booking_service
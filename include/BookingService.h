@@ -1,5 +1,6 @@
 #pragma once
 #include "DataStore.h"
+#include "Trace.h"
 
 #include <memory>
 
@@ -7,6 +8,8 @@ namespace booking_service {
 
 /**
  * @brief Thin wrapper around DataStore that exposes a clean service interface.
+ *
+ * Seat reads and bookings can be captured into a TraceRecorder for later replay.
  */
 class BookingService {
 public:
@@ -15,10 +18,49 @@ public:
     std::vector<Movie> GetMovies() const;
     std::vector<Theater> GetTheaters(int movieId) const;
     std::vector<Seat> GetSeats(int theaterId, int movieId) const;
-    bool BookSeats(int theaterId, int movieId, const std::vector<std::string>& seatIds);
+    BookingResult BookSeats(int theaterId, int movieId, const std::vector<std::string>& seatIds);
+
+    std::vector<int> SearchMovies(std::string_view query, std::size_t limit) const;
+    std::vector<int> SearchTheaters(std::string_view query, std::size_t limit) const;
+
+    std::vector<Screening> GetScreenings(int movieId,
+                                         std::chrono::sys_seconds from,
+                                         std::chrono::sys_seconds to) const;
+    std::vector<Screening> GetTheaterScreenings(int theaterId,
+                                                std::chrono::sys_seconds from,
+                                                std::chrono::sys_seconds to) const;
+    std::vector<Seat> GetSeats(int screeningId) const;
+    BookingResult BookSeats(int screeningId, const std::vector<std::string>& seatIds);
+    std::vector<std::string> FindFreeSeats(int screeningId, std::size_t count) const;
+
+    /**
+     * @brief Coroutine versions of BookSeats/GetSeats that suspend instead of queueing behind other bookings.
+     *
+     * Suspended calls resume on `executor`. These calls are not recorded by the trace recorder.
+     */
+    DataStore::BookingAwaiter BookSeatsAsync(int theaterId,
+                                             int movieId,
+                                             const std::vector<std::string>& seatIds,
+                                             Executor& executor);
+    DataStore::BookingAwaiter BookSeatsAsync(int screeningId,
+                                             const std::vector<std::string>& seatIds,
+                                             Executor& executor);
+    DataStore::SeatsAwaiter GetSeatsAsync(int theaterId, int movieId, Executor& executor);
+    DataStore::SeatsAwaiter GetSeatsAsync(int screeningId, Executor& executor);
+
+    /**
+     * @brief Starts recording GetSeats/BookSeats calls into the given recorder (nullptr stops recording).
+     *
+     * Must be set before requests are served.
+     */
+    void SetTraceRecorder(std::shared_ptr<TraceRecorder> recorder);
 
 private:
+    template <class MakeEvent, class Call>
+    auto Traced(MakeEvent&& makeEvent, Call&& call) const;
+
     std::shared_ptr<DataStore> dataStore;
+    std::shared_ptr<TraceRecorder> traceRecorder;
 };
 
 }  // namespace booking_service
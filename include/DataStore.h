@@ -1,6 +1,12 @@
 #pragma once
+#include "Async.h"
 #include "Models.h"
+#include "SearchIndex.h"
+#include "SeatStore.h"
 
+#include <atomic>
+#include <coroutine>
+#include <functional>
 #include <map>
 #include <unordered_map>
 #include <optional>
@@ -14,11 +20,37 @@ namespace fs = std::filesystem;
 
 namespace booking_service {
 
+/**
+ * @brief Computes the price of one seat from its base price and the live state of the show.
+ */
+using PricingPolicy = std::function<std::int64_t(std::int64_t basePrice, const PricingContext& context)>;
+
+/**
+ * @brief Per-show admission control for bookings.
+ *
+ * With combining enabled, bookings of one show wait in a FIFO queue instead of contending
+ * for the show mutex. One waiting thread at a time takes the whole queue and applies it
+ * under a single lock acquisition, then hands that role to the oldest thread still waiting.
+ * Coroutines never wait for the role: the thread holding it applies their requests and only
+ * posts their resumption.
+ */
+struct AdmissionPolicy {
+    bool combineBookings = true;
+    /// Per show, counting the batch being applied as well as the queue; must be positive.
+    /// Bookings beyond it fail fast with BookingStatus::Overloaded.
+    std::size_t maxQueuedBookings = 256;
+};
+
 /**
  * @brief In-memory storage for movies, theaters and seat bookings.
  *  - Movies, theaters and mappings are loaded once and never change.
- *  - Each (movieId, theaterId) pair has its own Show with its own seat state.
+ *  - Each screening of a (movieId, theaterId) pair has its own Show with its own seat state.
  *  - Show objects use per-show mutexes, so different shows can be booked in parallel.
+ *  - Bookings of one show are queued and applied in batches (see AdmissionPolicy);
+ *    a sold-out show rejects bookings from its counter without touching any lock.
+ *  - Coroutine callers use BookSeatsAsync/GetSeatsAsync, which suspend instead of waiting
+ *    for the show lock or behind other bookings of the show.
+ *  - Screenings are indexed by start time per movie and per theater for range queries.
  */
 class DataStore {
 public:
@@ -34,6 +66,11 @@ public:
      *
      * After loading, the static data (movies, theaters, mappings) does not change.
      * Seat states for each show are initialized based on theater capacity.
+     * Search indexes over movie titles and theater names are built here as well.
+     * Theaters may split their seats into priced seat classes, and mappings may
+     * override those prices per show and list showtimes as seconds since the epoch or as
+     * "YYYY-MM-DDTHH:MM[:SS]" followed by nothing or "Z" (UTC) or a "+HH:MM"/"-HH:MM" offset.
+     * A mapping without showtimes gets one screening without a start time.
      * @param dataDir Path to directory containing JSON configuration files.
      */
     void LoadData(const fs::path& dataDir);
@@ -61,15 +98,89 @@ public:
      */
     std::optional<Theater> GetTheater(int theaterId) const;
 
+    /**
+     * @brief Searches movie titles by words or word prefixes, ignoring case and diacritics.
+     *
+     * @param query Text typed by the user, e.g. "inter" or "matr".
+     * @param limit Maximum number of results.
+     * @return Movie ids, best matches first.
+     */
+    std::vector<int> SearchMovies(std::string_view query, std::size_t limit) const;
+
+    /**
+     * @brief Searches theater names the same way as SearchMovies.
+     *
+     * @return Theater ids, best matches first.
+     */
+    std::vector<int> SearchTheaters(std::string_view query, std::size_t limit) const;
+
+    /**
+     * @brief Retrieves a screening by ID.
+     *
+     * @param screeningId Screening ID assigned at load time.
+     * @return Optional containing Screening if found, otherwise std::nullopt.
+     */
+    std::optional<Screening> GetScreening(int screeningId) const;
+
+    /**
+     * @brief Retrieves the screening addressed by the (theaterId, movieId) overloads: the earliest one of the pair.
+     *
+     * @return Optional containing Screening if the movie is shown in the theater, otherwise std::nullopt.
+     */
+    std::optional<Screening> GetScreening(int theaterId, int movieId) const;
+
+    /**
+     * @brief Returns screenings of a movie across all theaters starting in [from, to).
+     *
+     * Runs in O(log n + k) over the movie's time-ordered schedule.
+     * @return Screenings ordered by start time. Empty if the movie is unknown.
+     */
+    std::vector<Screening> GetScreenings(int movieId,
+                                         std::chrono::sys_seconds from,
+                                         std::chrono::sys_seconds to) const;
+
+    /**
+     * @brief Returns screenings in a theater starting in [from, to), ordered by start time.
+     */
+    std::vector<Screening> GetTheaterScreenings(int theaterId,
+                                                std::chrono::sys_seconds from,
+                                                std::chrono::sys_seconds to) const;
+
     /**
      * @brief Books the given seats for a specific (movieId, theaterId) show.
+     * When the pair has several screenings, the earliest one is used.
      *  - All seats must exist.
      *  - None of them may already be booked.
      *  - The operation is atomic: if one seat fails, nothing is booked.
      *
-     * @return true on success, false otherwise.
+     * Fails with BookingStatus::SoldOut once every seat is booked and with
+     * BookingStatus::Overloaded when the show's booking queue is full.
+     * The total price is computed after the show lock is released, from the show's
+     * price table and the pricing policy (if any).
+     * @return Result that is true on success and carries the status and total price.
+     */
+    BookingResult BookSeats(int theaterId, int movieId, const std::vector<std::string>& seatIds);
+
+    /**
+     * @brief Books the given seats for a specific screening, with the same rules as above.
+     */
+    BookingResult BookSeats(int screeningId, const std::vector<std::string>& seatIds);
+
+    /**
+     * @brief Installs a dynamic pricing policy applied to every booked seat.
+     *
+     * The policy receives the show's occupancy from maintained counters, so it never scans seats.
+     * It runs outside the show lock and may be called concurrently from several threads.
+     * Must be set before bookings start; an empty policy restores static prices.
      */
-    bool BookSeats(int theaterId, int movieId, const std::vector<std::string>& seatIds);
+    void SetPricingPolicy(PricingPolicy policy);
+
+    /**
+     * @brief Configures how concurrent bookings of one show are admitted. Must be set before bookings start.
+     *
+     * Throws std::invalid_argument if maxQueuedBookings is 0, which would reject every combined booking.
+     */
+    void SetAdmissionPolicy(AdmissionPolicy policy);
 
     /**
      * @brief Returns a thread-safe copy of seats for a specific show.
@@ -80,18 +191,208 @@ public:
      */
     std::vector<Seat> GetSeats(int theaterId, int movieId) const;
 
+    /**
+     * @brief Returns a thread-safe copy of seats for a specific screening.
+     *
+     * @return Vector of Seat objects. Empty vector if screening does not exist.
+     */
+    std::vector<Seat> GetSeats(int screeningId) const;
+
+    /**
+     * @brief Finds up to `count` free seats of a screening, in layout order.
+     *
+     * Large venues skip fully booked blocks of seats, so the search stays fast even when
+     * only a few seats are left.
+     * @return Seat ids; fewer than `count` if the screening has fewer free seats, empty if it does not exist.
+     */
+    std::vector<std::string> FindFreeSeats(int screeningId, std::size_t count) const;
+
+    class BookingAwaiter;
+    class SeatsAwaiter;
+
+    /**
+     * @brief Books seats from a coroutine without blocking the calling thread; co_await the result.
+     *
+     * Same rules and result as BookSeats, and the calling thread never waits for a lock held by
+     * another thread. When nobody else is working on the show and its lock is free, the booking is
+     * applied right away, together with whatever else is queued, and co_await does not suspend.
+     * Otherwise the request joins the show's queue and the coroutine is resumed on `executor` once
+     * the thread working on the show has applied it. Blocking callers never wait for an executor,
+     * so blocking calls may be made from the executor's own thread. Coroutine requests queued while
+     * only other coroutines are waiting are applied one batch at a time, from the executor of the
+     * oldest one or by the next caller to reach the show, whichever comes first.
+     * Coroutine bookings always go through the queue, whatever AdmissionPolicy::combineBookings says.
+     * The store and the executor must outlive the request. Destroying the coroutine while it is
+     * suspended withdraws the request if it has not been applied yet.
+     */
+    BookingAwaiter BookSeatsAsync(int screeningId, const std::vector<std::string>& seatIds, Executor& executor);
+
+    /**
+     * @brief Books seats of the earliest screening of a (theaterId, movieId) pair; see above.
+     */
+    BookingAwaiter BookSeatsAsync(int theaterId,
+                                  int movieId,
+                                  const std::vector<std::string>& seatIds,
+                                  Executor& executor);
+
+    /**
+     * @brief Reads the seats of a screening from a coroutine without blocking the calling thread.
+     *
+     * Yields the same result as GetSeats. Suspends only if the show lock is taken, and then
+     * resumes on `executor` with a copy taken by the thread that applies the show's queue.
+     */
+    SeatsAwaiter GetSeatsAsync(int screeningId, Executor& executor);
+
+    /**
+     * @brief Reads the seats of the earliest screening of a (theaterId, movieId) pair; see above.
+     */
+    SeatsAwaiter GetSeatsAsync(int theaterId, int movieId, Executor& executor);
+
+    /**
+     * @brief Returns the number of successful bookings applied to a screening so far.
+     *
+     * @return Optional containing the version, std::nullopt if the screening does not exist.
+     */
+    std::optional<std::uint64_t> GetVersion(int screeningId) const;
+
+    /**
+     * @brief Streams the catalog and the seat state of every show to a binary snapshot file.
+     *
+     * Bookings continue while exporting: each show is locked only while its bitmap is copied,
+     * so every show is captured at a consistent point (with its version), but different shows
+     * may be captured at different moments.
+     * Throws std::runtime_error if the file cannot be written.
+     * @param file Destination path; overwritten if it exists.
+     */
+    void ExportSnapshot(const fs::path& file) const;
+
+    /**
+     * @brief Replaces the whole store with the contents of a snapshot written by ExportSnapshot.
+     *
+     * Like LoadData, must not run concurrently with other calls.
+     * The whole file is parsed and validated before anything is replaced: on failure it throws
+     * std::runtime_error and the store keeps its previous contents. Pricing and admission
+     * policies are kept either way.
+     * @param file Snapshot path.
+     */
+    void ImportSnapshot(const fs::path& file);
+
 private:
+    using SeatIndex = std::unordered_map<std::string, std::uint32_t>;
+
+    /**
+     * @brief A booking or seat read waiting in a show's queue.
+     *
+     * Lives on the stack of a blocked thread, or in the frame of a suspended coroutine (with
+     * executor and continuation set, so completing it resumes the coroutine on its executor).
+     * Only ops without an executor are ever handed the combiner role.
+     */
+    struct PendingOp {
+        enum class State {
+            Waiting,
+            Combine,  ///< Handed the combiner role by the previous combiner (blocked threads only).
+            Done,     ///< Applied by a combiner; the results below are set.
+        };
+
+        const std::vector<std::uint32_t>* seats = nullptr;  ///< Seats to book; nullptr for a read.
+        BookingStatus status = BookingStatus::Rejected;
+        int bookedBefore = 0;
+        SeatState seatState;  ///< Copy of the show's seat state, taken for reads.
+        Executor* executor = nullptr;
+        std::coroutine_handle<> continuation;
+        bool queued = false;  ///< A coroutine suspended on it; set under the show's queueMtx.
+        std::atomic<State> state{State::Waiting};  ///< Changed and notified under the show's queueMtx.
+    };
+
     /**
-     * @brief Internal representation of a single movie show in a particular theater.
-     *   - A local seat state (copy of Theater.seats)
+     * @brief Internal representation of a single screening in a particular theater.
+     *   - The screening and the theater layout it uses (shared by all screenings of the theater)
+     *   - A seat state backend sized for the layout (see SeatState)
+     *   - A price per seat class (immutable after loading)
+     *   - A counter of booked seats and a version (successful bookings), readable without the lock
      *   - A mutex for protecting modifications
-     * Each Show corresponds uniquely to a (<movieId>, <theaterId>) pair.
+     *   - A queue of pending operations, guarded by its own mutex, and the batch being applied
+     *     (owned by the current combiner)
+     *   - A flag raised by a coroutine that found the show lock taken with nobody combining, so
+     *     that the lock holder applies the queue when it unlocks
+     * Each Show corresponds uniquely to a screening id.
      */
     struct Show {
-        std::vector<Seat> seats;
+        Screening screening;
+        const Theater* theater = nullptr;
+        const SeatIndex* seatIndex = nullptr;
+        std::vector<std::int64_t> classPrices;
+        SeatState seatState;
+        std::atomic<int> bookedSeats{0};
+        std::atomic<std::uint64_t> version{0};
         mutable std::mutex mtx;
+
+        std::mutex queueMtx;
+        std::vector<PendingOp*> queue;
+        std::vector<PendingOp*> batch;
+        std::size_t pendingBookings = 0;  ///< Bookings in queue and batch, checked against maxQueuedBookings.
+        bool combining = false;
+        std::atomic<bool> stranded{false};
     };
 
+    /**
+     * @brief Entry of a time-ordered schedule, sorted by (startTime, screeningId).
+     */
+    struct ScheduleEntry {
+        std::chrono::sys_seconds startTime;
+        int screeningId;
+
+        auto operator<=>(const ScheduleEntry&) const = default;
+    };
+
+    using Schedule = std::vector<ScheduleEntry>;
+
+    void BuildSeatIndexes();
+    void ClearShows();
+    Show& AddShow(int movieId,
+                  int theaterId,
+                  std::optional<std::chrono::sys_seconds> startTime,
+                  std::vector<std::int64_t> classPrices);
+    void BuildScheduleAndSearchIndexes();
+    void ReadSnapshot(const fs::path& file);
+    void SwapData(DataStore& other) noexcept;
+    Show* FindShow(int screeningId);
+    Show* FindShow(int theaterId, int movieId);
+    static std::optional<BookingStatus> ResolveSeats(const Show& show,
+                                                     const std::vector<std::string>& seatIds,
+                                                     std::vector<std::uint32_t>& seatsToBook);
+    BookingResult BookShowSeats(Show& show, const std::vector<std::string>& seatIds);
+    BookingResult PriceBooking(const Show& show, const std::vector<std::uint32_t>& seatsToBook, int bookedBefore) const;
+    BookingStatus BookQueued(Show& show, const std::vector<std::uint32_t>& seatsToBook, int& bookedBefore);
+    bool SuspendQueued(Show& show, PendingOp& op);
+    static void WithdrawQueued(Show& show, PendingOp& op);
+    static bool TryLockShow(Show& show, std::unique_lock<std::mutex>& showLock);
+    /**
+     * @brief Unlocks a show lock taken outside the combiner, then applies the coroutine requests
+     * that queued behind it (blocking only if `mayBlock`).
+     *
+     * Readers use it too: they finish bookings the store has already accepted.
+     */
+    static void ReleaseShow(Show& show, std::unique_lock<std::mutex>& showLock, bool mayBlock);
+    static void DrainQueued(Show& show);
+    static void CombinePending(Show& show,
+                               std::unique_lock<std::mutex>& queueLock,
+                               std::unique_lock<std::mutex>& showLock);
+    static void CombineOnce(Show& show,
+                            std::unique_lock<std::mutex>& queueLock,
+                            std::unique_lock<std::mutex>& showLock);
+    static void ApplyBatch(Show& show,
+                           std::unique_lock<std::mutex>& queueLock,
+                           std::unique_lock<std::mutex>& showLock);
+    static bool HandOff(Show& show);
+    static BookingStatus ApplyBooking(Show& show, const std::vector<std::uint32_t>& seatsToBook, int& bookedBefore);
+    static std::vector<Seat> BuildSeats(const Show& show, const SeatState& seatState);
+    std::vector<Seat> CopyShowSeats(Show& show) const;
+    std::vector<Screening> CollectScreenings(const std::map<int, Schedule>& schedules,
+                                             int key,
+                                             std::chrono::sys_seconds from,
+                                             std::chrono::sys_seconds to) const;
+
     struct PairHash {
         template <class T1, class T2>
         std::size_t operator()(const std::pair<T1, T2>& p) const {
@@ -104,7 +405,63 @@ private:
     std::map<int, Movie> mapMovies;
     std::map<int, std::vector<int>> mapMovieTheaters;
     std::map<int, Theater> mapTheaters;
-    std::unordered_map<std::pair<int, int>, std::unique_ptr<Show>, PairHash> mapShows;
+    std::map<int, SeatIndex> mapSeatIndex;
+    std::vector<std::unique_ptr<Show>> shows;  // indexed by screening id
+    std::unordered_map<std::pair<int, int>, int, PairHash> mapShows;  // (movieId, theaterId) → earliest screening id
+    std::map<int, Schedule> movieSchedules;
+    std::map<int, Schedule> theaterSchedules;
+    SearchIndex movieSearch;
+    SearchIndex theaterSearch;
+    PricingPolicy pricingPolicy;
+    AdmissionPolicy admissionPolicy;
+};
+
+/**
+ * @brief Awaitable returned by DataStore::BookSeatsAsync; co_await yields the BookingResult.
+ */
+class DataStore::BookingAwaiter {
+public:
+    BookingAwaiter(const BookingAwaiter&) = delete;
+    BookingAwaiter& operator=(const BookingAwaiter&) = delete;
+    ~BookingAwaiter();
+
+    bool await_ready() const noexcept { return decided.has_value(); }
+    bool await_suspend(std::coroutine_handle<> continuation);
+    BookingResult await_resume() const;
+
+private:
+    friend class DataStore;
+
+    BookingAwaiter(DataStore& store, Show* show, const std::vector<std::string>& seatIds, Executor& executor);
+
+    DataStore& store;
+    Show* show;
+    std::vector<std::uint32_t> seatsToBook;
+    std::optional<BookingStatus> decided;  ///< Outcome known without queueing (bad request, sold out).
+    PendingOp op;
+};
+
+/**
+ * @brief Awaitable returned by DataStore::GetSeatsAsync; co_await yields the seats.
+ */
+class DataStore::SeatsAwaiter {
+public:
+    SeatsAwaiter(const SeatsAwaiter&) = delete;
+    SeatsAwaiter& operator=(const SeatsAwaiter&) = delete;
+    ~SeatsAwaiter();
+
+    bool await_ready();
+    bool await_suspend(std::coroutine_handle<> continuation);
+    std::vector<Seat> await_resume() const;
+
+private:
+    friend class DataStore;
+
+    SeatsAwaiter(DataStore& store, Show* show, Executor& executor);
+
+    DataStore& store;
+    Show* show;
+    PendingOp op;
 };
 
 }  // namespace booking_service
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -11,21 +14,35 @@ namespace booking_service {
  * Seat identifiers are labels such as "a1", "a2", ...
  * The booking state is tracked by the backend and updated atomically when a
  * reservation request succeeds.
+ * The seat class is an index into Theater::seatClasses and never changes after loading.
  */
 struct Seat {
     std::string id;
     bool isBooked = false;
+    std::uint16_t seatClass = 0;
+};
+
+/**
+ * @brief A pricing tier of a theater layout (e.g. "standard", "vip").
+ *
+ * Prices are expressed in minor currency units (cents, kopecks, ...).
+ */
+struct SeatClass {
+    std::string name;
+    std::int64_t price = 0;
 };
 
 /**
  * @brief Represents a theater that can host movie shows.
  *
- * Each theater has a unique numeric id, a name, and a predefined list of seats.
+ * Each theater has a unique numeric id, a name, a predefined list of seats
+ * and the seat classes those seats belong to.
  */
 struct Theater {
     int id;
     std::string name;
     std::vector<Seat> seats;
+    std::vector<SeatClass> seatClasses;
 };
 
 /**
@@ -38,4 +55,54 @@ struct Movie {
     std::string title;
 };
 
+/**
+ * @brief A single screening of a movie in a theater at a given start time.
+ *
+ * Screening ids are assigned by the DataStore when data is loaded.
+ * Mappings without showtimes produce one screening without a start time; it is reachable
+ * by id or by (theaterId, movieId) but not through time-range queries.
+ */
+struct Screening {
+    int id;
+    int movieId;
+    int theaterId;
+    std::optional<std::chrono::sys_seconds> startTime;
+};
+
+/**
+ * @brief Why a booking request succeeded or failed.
+ */
+enum class BookingStatus {
+    Booked,
+    Rejected,    ///< Unknown show or seat, or a requested seat is already booked.
+    SoldOut,     ///< The show has no free seats left.
+    Overloaded,  ///< Too many bookings are already waiting for the show; the request may be retried.
+};
+
+/**
+ * @brief Outcome of a booking request.
+ *
+ * Converts to true when the booking succeeded. totalPrice is the sum of the
+ * prices of all booked seats and is 0 for failed bookings.
+ */
+struct BookingResult {
+    BookingStatus status = BookingStatus::Rejected;
+    std::int64_t totalPrice = 0;
+
+    explicit operator bool() const { return status == BookingStatus::Booked; }
+};
+
+/**
+ * @brief Live state of a show passed to the dynamic pricing policy.
+ */
+struct PricingContext {
+    int screeningId;
+    int movieId;
+    int theaterId;
+    std::optional<std::chrono::sys_seconds> startTime;  ///< Unset for unscheduled screenings.
+    std::uint16_t seatClass;
+    int capacity;
+    int bookedSeats;  ///< Seats booked before the current request.
+};
+
 }  // namespace booking_service
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace booking_service {
+
+/**
+ * @brief Prefix search over short texts such as movie titles and theater names.
+ *  - Texts are folded (lowercase, Latin diacritics stripped, Cyrillic lowercased) and split into words.
+ *  - Words live in a sorted dictionary, so all words with a given prefix form one contiguous range.
+ *  - Every query word must prefix-match some word of a document; results are ranked by relevance.
+ *
+ * Documents are added once and then Build() is called; after that the index is read-only
+ * and Search() may be called from any number of threads.
+ */
+class SearchIndex {
+public:
+    /**
+     * @brief Adds a document to the index. Must be called before Build().
+     *
+     * @param id External id returned by Search() (e.g. a movie id).
+     * @param text Text to index (UTF-8).
+     */
+    void Add(int id, std::string_view text);
+
+    /**
+     * @brief Sorts the dictionary and finalizes the index.
+     */
+    void Build();
+
+    /**
+     * @brief Removes all documents.
+     */
+    void Clear();
+
+    /**
+     * @brief Returns ids of documents matching every word of the query, best matches first.
+     *
+     * A document scores higher when query words match whole words rather than prefixes
+     * and when they match the leading word; shorter documents win ties.
+     * @param query Free text typed by the user (UTF-8).
+     * @param limit Maximum number of ids to return.
+     * @return Ranked ids. Empty if the query has no words or nothing matches.
+     */
+    std::vector<int> Search(std::string_view query, std::size_t limit) const;
+
+    /**
+     * @brief Folds text for matching: ASCII lowercase, Latin-1/Latin Extended-A letters
+     * reduced to their base letters and Cyrillic capitals lowercased.
+     */
+    static std::string Fold(std::string_view text);
+
+private:
+    struct Posting {
+        std::uint32_t doc;
+        std::uint16_t position;
+    };
+
+    struct Term {
+        std::string word;
+        std::uint32_t firstPosting;
+        std::uint32_t lastPosting;
+    };
+
+    struct PendingPosting {
+        std::string word;
+        Posting posting;
+    };
+
+    static std::vector<std::string> Tokenize(std::string_view text);
+
+    std::vector<int> docIds;
+    std::vector<std::uint16_t> docLengths;
+    std::vector<Term> terms;
+    std::vector<Posting> postings;
+    std::vector<PendingPosting> pending;
+};
+
+}  // namespace booking_service
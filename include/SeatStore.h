@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+namespace booking_service {
+
+inline constexpr std::size_t kSeatsPerWord = 64;
+
+constexpr std::size_t SeatWordCount(std::size_t capacity) {
+    return (capacity + kSeatsPerWord - 1) / kSeatsPerWord;
+}
+
+namespace detail {
+
+/**
+ * @brief Appends the free seats of one bitmap word to out, stopping at capacity or at `count` seats in total.
+ */
+void CollectFreeSeats(std::uint64_t bookedWord,
+                      std::size_t wordIndex,
+                      std::uint32_t capacity,
+                      std::size_t count,
+                      std::vector<std::uint32_t>& out);
+
+/**
+ * @brief Bits of the last bitmap word that lie past the last seat.
+ */
+constexpr std::uint64_t PaddingBits(std::uint32_t capacity) {
+    const std::size_t usedBits = capacity % kSeatsPerWord;
+    return usedBits == 0 ? 0 : ~std::uint64_t{0} << usedBits;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Bitmap stored inline in the show, for halls of up to 64 * Words seats.
+ *
+ * FixedSeatStore<1> keeps a whole small hall in a single word next to the show's other fields.
+ * Seats at or past the capacity read as booked and are never booked.
+ */
+template <std::size_t Words>
+class FixedSeatStore {
+public:
+    static constexpr std::size_t kMaxSeats = Words * kSeatsPerWord;
+
+    FixedSeatStore() = default;
+    explicit FixedSeatStore(std::uint32_t capacity)
+        : capacity(static_cast<std::uint32_t>(std::min<std::size_t>(capacity, kMaxSeats))) {
+    }
+
+    bool IsBooked(std::uint32_t seat) const {
+        return seat >= capacity || seat >= kMaxSeats || (words[seat / kSeatsPerWord] >> (seat % kSeatsPerWord)) & 1;
+    }
+
+    void Book(std::uint32_t seat) {
+        if (seat < capacity && seat < kMaxSeats) {
+            words[seat / kSeatsPerWord] |= std::uint64_t{1} << (seat % kSeatsPerWord);
+        }
+    }
+
+    void FindFree(std::size_t count, std::vector<std::uint32_t>& out) const {
+        for (std::size_t w = 0; w < SeatWordCount(capacity) && out.size() < count; ++w) {
+            detail::CollectFreeSeats(words[w], w, capacity, count, out);
+        }
+    }
+
+    std::vector<std::uint64_t> Bitmap() const { return {words.begin(), words.begin() + SeatWordCount(capacity)}; }
+
+    /**
+     * @brief Replaces the bitmap; returns false if the word count does not match the capacity
+     * or a bit past the last seat is set.
+     */
+    bool Assign(const std::vector<std::uint64_t>& bits) {
+        if (bits.size() != SeatWordCount(capacity)) {
+            return false;
+        }
+        if (!bits.empty() && (bits.back() & detail::PaddingBits(capacity))) {
+            return false;
+        }
+        words = {};
+        std::copy(bits.begin(), bits.end(), words.begin());
+        return true;
+    }
+
+private:
+    std::array<std::uint64_t, Words> words{};
+    std::uint32_t capacity = 0;
+};
+
+/**
+ * @brief Two-level bitmap for large venues.
+ *
+ * Besides the seat words it keeps summary words with one bit per seat word, set once that
+ * word is fully booked. Free-seat search skips 4096 seats per full summary word, so finding
+ * the last free seats of a stadium reads a few dozen words instead of the whole bitmap.
+ * Both levels share one allocation, and the bits past the last seat are kept set so that
+ * "word is full" is a single comparison. Seats at or past the capacity read as booked and are
+ * never booked.
+ */
+class HierarchicalSeatStore {
+public:
+    HierarchicalSeatStore() = default;
+    explicit HierarchicalSeatStore(std::uint32_t capacity);
+
+    bool IsBooked(std::uint32_t seat) const {
+        return seat >= capacity || (bits[seat / kSeatsPerWord] >> (seat % kSeatsPerWord)) & 1;
+    }
+
+    void Book(std::uint32_t seat) {
+        if (seat >= capacity) {
+            return;
+        }
+        const std::size_t w = seat / kSeatsPerWord;
+        bits[w] |= std::uint64_t{1} << (seat % kSeatsPerWord);
+        if (bits[w] == ~std::uint64_t{0}) {
+            bits[wordCount + w / kSeatsPerWord] |= std::uint64_t{1} << (w % kSeatsPerWord);
+        }
+    }
+
+    void FindFree(std::size_t count, std::vector<std::uint32_t>& out) const;
+
+    std::vector<std::uint64_t> Bitmap() const;
+
+    /**
+     * @brief Replaces the bitmap; returns false if the word count does not match the capacity
+     * or a bit past the last seat is set.
+     */
+    bool Assign(const std::vector<std::uint64_t>& bitmap);
+
+private:
+    std::vector<std::uint64_t> bits;  ///< wordCount seat words, then one summary bit per seat word.
+    std::uint32_t wordCount = 0;
+    std::uint32_t capacity = 0;
+};
+
+/**
+ * @brief Seat state of one show: one booked bit per seat of the theater layout.
+ *
+ * The alternative is picked from the theater capacity by MakeSeatState. Every backend has the
+ * same members, so DataStore dispatches once per call with std::visit and the per-seat work is
+ * compiled for the concrete layout:
+ *  - IsBooked(seat) / Book(seat) for a seat index below the capacity
+ *  - FindFree(count, out) appends up to count free seat indices in layout order
+ *  - Bitmap() / Assign(words) expose the flat bitmap of SeatWordCount(capacity) words
+ *
+ * None of them is thread-safe; callers hold the show lock.
+ */
+using SeatState = std::variant<FixedSeatStore<1>, FixedSeatStore<4>, HierarchicalSeatStore>;
+
+/**
+ * @brief Returns an empty seat state for the given capacity:
+ *  - up to 64 seats: FixedSeatStore<1>
+ *  - up to 256 seats: FixedSeatStore<4>
+ *  - larger venues: HierarchicalSeatStore
+ */
+SeatState MakeSeatState(std::uint32_t capacity);
+
+}  // namespace booking_service
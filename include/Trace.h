@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace booking_service {
+
+/**
+ * @brief Kind of BookingService call captured in a trace.
+ */
+enum class TraceOp {
+    BookSeats,
+    GetSeats,
+};
+
+/**
+ * @brief A single recorded (or generated) BookingService call.
+ *
+ * A call addresses either a screening (screeningId >= 0) or the earliest screening of a
+ * (theaterId, movieId) pair (screeningId == -1).
+ */
+struct TraceEvent {
+    std::int64_t startNs = 0;     ///< Call start, relative to the start of the trace.
+    std::int64_t durationNs = 0;  ///< Call duration; 0 for generated events.
+    TraceOp op = TraceOp::BookSeats;
+    int screeningId = -1;
+    int theaterId = -1;
+    int movieId = -1;
+    std::optional<bool> success{};  ///< Recorded booking outcome; empty for reads and generated events.
+    std::vector<std::string> seatIds{};
+};
+
+/**
+ * @brief Thread-safe sink for BookingService calls.
+ *
+ * Events are appended in completion order; startNs gives the call order.
+ */
+class TraceRecorder {
+public:
+    TraceRecorder();
+
+    /**
+     * @brief Nanoseconds elapsed since the recorder was created.
+     */
+    std::int64_t Now() const;
+
+    void Record(TraceEvent event);
+
+    /**
+     * @brief Returns a copy of the recorded events ordered by start time.
+     */
+    std::vector<TraceEvent> Events() const;
+
+private:
+    std::chrono::steady_clock::time_point start;
+    mutable std::mutex mtx;
+    std::vector<TraceEvent> events;
+};
+
+/**
+ * @brief Writes events as text, one call per line.
+ *
+ * Line format: <startNs> <durationNs> <book|seats> <screeningId> <theaterId> <movieId> <1|0|-> <seat,seat,...|->
+ * Seat ids are percent-encoded, so ids containing ',', '-', '%', whitespace or control characters
+ * round-trip unchanged. Throws std::runtime_error if the file cannot be written or an event has
+ * an empty seat id, which the format cannot represent.
+ */
+void SaveTrace(const fs::path& file, const std::vector<TraceEvent>& events);
+
+/**
+ * @brief Reads events written by SaveTrace. Lines starting with '#' are comments.
+ *
+ * Throws std::runtime_error if the file cannot be read or a line is malformed.
+ */
+std::vector<TraceEvent> LoadTrace(const fs::path& file);
+
+}  // namespace booking_service
@@ -0,0 +1,28 @@
+#include "Async.h"
+
+namespace booking_service {
+
+LoopExecutor::~LoopExecutor() {
+    while (RunPending() > 0) {
+    }
+}
+
+void LoopExecutor::Post(std::function<void()> work) {
+    std::lock_guard lock(mtx);
+    pending.push_back(std::move(work));
+}
+
+std::size_t LoopExecutor::RunPending() {
+    {
+        std::lock_guard lock(mtx);
+        running.swap(pending);
+    }
+    for (auto& work : running) {
+        work();
+    }
+    const std::size_t count = running.size();
+    running.clear();
+    return count;
+}
+
+}  // namespace booking_service
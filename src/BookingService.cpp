@@ -1,11 +1,34 @@
 #include "BookingService.h"
 
+#include <type_traits>
+
 namespace booking_service {
 
 BookingService::BookingService(std::shared_ptr<DataStore> store)
     : dataStore(std::move(store)) {
 }
 
+template <class MakeEvent, class Call>
+auto BookingService::Traced(MakeEvent&& makeEvent, Call&& call) const {
+    if (!traceRecorder) {
+        return call();
+    }
+
+    TraceEvent event = makeEvent();
+    event.startNs = traceRecorder->Now();
+    auto result = call();
+    event.durationNs = traceRecorder->Now() - event.startNs;
+    if constexpr (std::is_same_v<decltype(result), BookingResult>) {
+        event.success = static_cast<bool>(result);
+    }
+    traceRecorder->Record(std::move(event));
+    return result;
+}
+
+void BookingService::SetTraceRecorder(std::shared_ptr<TraceRecorder> recorder) {
+    traceRecorder = std::move(recorder);
+}
+
 std::vector<Movie> BookingService::GetMovies() const {
     return dataStore->GetMovies();
 }
@@ -15,11 +38,72 @@ std::vector<Theater> BookingService::GetTheaters(int movieId) const {
 }
 
 std::vector<Seat> BookingService::GetSeats(int theaterId, int movieId) const {
-    return dataStore->GetSeats(theaterId, movieId);
+    return Traced([&] { return TraceEvent{.op = TraceOp::GetSeats, .theaterId = theaterId, .movieId = movieId}; },
+                  [&] { return dataStore->GetSeats(theaterId, movieId); });
+}
+
+BookingResult BookingService::BookSeats(int theaterId, int movieId, const std::vector<std::string>& seatIds) {
+    return Traced(
+        [&] {
+            return TraceEvent{
+                .op = TraceOp::BookSeats, .theaterId = theaterId, .movieId = movieId, .seatIds = seatIds};
+        },
+        [&] { return dataStore->BookSeats(theaterId, movieId, seatIds); });
+}
+
+std::vector<int> BookingService::SearchMovies(std::string_view query, std::size_t limit) const {
+    return dataStore->SearchMovies(query, limit);
+}
+
+std::vector<int> BookingService::SearchTheaters(std::string_view query, std::size_t limit) const {
+    return dataStore->SearchTheaters(query, limit);
+}
+
+std::vector<Screening> BookingService::GetScreenings(int movieId,
+                                                     std::chrono::sys_seconds from,
+                                                     std::chrono::sys_seconds to) const {
+    return dataStore->GetScreenings(movieId, from, to);
+}
+
+std::vector<Screening> BookingService::GetTheaterScreenings(int theaterId,
+                                                            std::chrono::sys_seconds from,
+                                                            std::chrono::sys_seconds to) const {
+    return dataStore->GetTheaterScreenings(theaterId, from, to);
+}
+
+std::vector<Seat> BookingService::GetSeats(int screeningId) const {
+    return Traced([&] { return TraceEvent{.op = TraceOp::GetSeats, .screeningId = screeningId}; },
+                  [&] { return dataStore->GetSeats(screeningId); });
+}
+
+BookingResult BookingService::BookSeats(int screeningId, const std::vector<std::string>& seatIds) {
+    return Traced([&] { return TraceEvent{.op = TraceOp::BookSeats, .screeningId = screeningId, .seatIds = seatIds}; },
+                  [&] { return dataStore->BookSeats(screeningId, seatIds); });
+}
+
+std::vector<std::string> BookingService::FindFreeSeats(int screeningId, std::size_t count) const {
+    return dataStore->FindFreeSeats(screeningId, count);
+}
+
+DataStore::BookingAwaiter BookingService::BookSeatsAsync(int theaterId,
+                                                         int movieId,
+                                                         const std::vector<std::string>& seatIds,
+                                                         Executor& executor) {
+    return dataStore->BookSeatsAsync(theaterId, movieId, seatIds, executor);
+}
+
+DataStore::BookingAwaiter BookingService::BookSeatsAsync(int screeningId,
+                                                         const std::vector<std::string>& seatIds,
+                                                         Executor& executor) {
+    return dataStore->BookSeatsAsync(screeningId, seatIds, executor);
+}
+
+DataStore::SeatsAwaiter BookingService::GetSeatsAsync(int theaterId, int movieId, Executor& executor) {
+    return dataStore->GetSeatsAsync(theaterId, movieId, executor);
 }
 
-bool BookingService::BookSeats(int theaterId, int movieId, const std::vector<std::string>& seatIds) {
-    return dataStore->BookSeats(theaterId, movieId, seatIds);
+DataStore::SeatsAwaiter BookingService::GetSeatsAsync(int screeningId, Executor& executor) {
+    return dataStore->GetSeatsAsync(screeningId, executor);
 }
 
-}  // namespace booking_service
\ No newline at end of file
+}  // namespace booking_service
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <numeric>
 #include <optional>
 #include <ranges>
 #include <stdexcept>
@@ -18,6 +19,7 @@ using json = nlohmann::json;
 constexpr std::string_view kMoviesFile = "movies.json";
 constexpr std::string_view kTheatersFile = "theaters.json";
 constexpr std::string_view kMappingsFile = "mappings.json";
+constexpr std::string_view kDefaultSeatClass = "standard";
 
 std::optional<json> LoadJson(const fs::path& path) {
     std::ifstream file(path);
@@ -36,6 +38,134 @@ std::optional<json> LoadJson(const fs::path& path) {
     return j;
 }
 
+/**
+ * Fills t.seats and t.seatClasses from the optional "seatClasses" array of a theater entry.
+ * Seats are assigned to classes in order: the first class gets a1..aN, the next one the following seats.
+ * Without "seatClasses" all seats belong to a single standard class priced by the optional "price" field.
+ */
+bool ParseSeatLayout(const json& item, int capacity, Theater& t) {
+    std::vector<int> classSeats;
+    if (item.contains("seatClasses")) {
+        const auto& classes = item["seatClasses"];
+        if (!classes.is_array() || classes.empty()) {
+            std::cerr << "[DataStore] Theater " << t.id << " has invalid seatClasses\n";
+            return false;
+        }
+        for (const auto& cls : classes) {
+            if (!cls.contains("name") || !cls.contains("seats") || !cls.contains("price")) {
+                std::cerr << "[DataStore] Theater " << t.id << " has seat class with missing fields\n";
+                return false;
+            }
+            const int seats = cls["seats"].get<int>();
+            const auto price = cls["price"].get<std::int64_t>();
+            if (seats <= 0 || price < 0) {
+                std::cerr << "[DataStore] Theater " << t.id << " has seat class with invalid seats or price\n";
+                return false;
+            }
+            t.seatClasses.push_back(SeatClass{cls["name"].get<std::string>(), price});
+            classSeats.push_back(seats);
+        }
+    }
+    else {
+        t.seatClasses.push_back(SeatClass{std::string(kDefaultSeatClass), item.value("price", std::int64_t{0})});
+        classSeats.push_back(capacity);
+    }
+
+    if (std::accumulate(classSeats.begin(), classSeats.end(), 0) != capacity) {
+        std::cerr << "[DataStore] Theater " << t.id << " seat classes do not add up to capacity\n";
+        return false;
+    }
+
+    t.seats.reserve(static_cast<std::size_t>(capacity));
+    for (std::size_t cls = 0; cls < classSeats.size(); ++cls) {
+        for (int i = 0; i < classSeats[cls]; ++i) {
+            const auto seatNo = t.seats.size() + 1;
+            t.seats.push_back(Seat{"a" + std::to_string(seatNo), false, static_cast<std::uint16_t>(cls)});
+        }
+    }
+    return true;
+}
+
+/**
+ * Reads exactly `digits` decimal digits starting at pos into value and advances pos past them.
+ */
+bool ReadDigits(std::string_view text, std::size_t& pos, std::size_t digits, unsigned& value) {
+    if (text.size() - pos < digits) {
+        return false;
+    }
+    value = 0;
+    for (const char c : text.substr(pos, digits)) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + static_cast<unsigned>(c - '0');
+    }
+    pos += digits;
+    return true;
+}
+
+bool ReadChar(std::string_view text, std::size_t& pos, char expected) {
+    if (pos < text.size() && text[pos] == expected) {
+        ++pos;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Parses a showtime given either as seconds since the epoch or as "YYYY-MM-DDTHH:MM[:SS]" followed by
+ * nothing or "Z" (UTC) or a "+HH:MM"/"-HH:MM" offset from UTC. The whole string must match.
+ */
+std::optional<std::chrono::sys_seconds> ParseShowtime(const json& value) {
+    if (value.is_number_integer()) {
+        return std::chrono::sys_seconds{std::chrono::seconds{value.get<std::int64_t>()}};
+    }
+    if (!value.is_string()) {
+        return std::nullopt;
+    }
+
+    const auto& text = value.get_ref<const std::string&>();
+    std::size_t pos = 0;
+    unsigned y = 0, mo = 0, d = 0, h = 0, mi = 0, sec = 0;
+    if (!ReadDigits(text, pos, 4, y) || !ReadChar(text, pos, '-') || !ReadDigits(text, pos, 2, mo) ||
+        !ReadChar(text, pos, '-') || !ReadDigits(text, pos, 2, d) || !ReadChar(text, pos, 'T') ||
+        !ReadDigits(text, pos, 2, h) || !ReadChar(text, pos, ':') || !ReadDigits(text, pos, 2, mi)) {
+        return std::nullopt;
+    }
+    if (ReadChar(text, pos, ':') && !ReadDigits(text, pos, 2, sec)) {
+        return std::nullopt;
+    }
+    if (h > 23 || mi > 59 || sec > 59) {
+        return std::nullopt;
+    }
+
+    std::chrono::minutes offset{0};
+    if (!ReadChar(text, pos, 'Z') && pos < text.size()) {
+        const bool negative = text[pos] == '-';
+        unsigned offsetH = 0, offsetMi = 0;
+        if ((!ReadChar(text, pos, '+') && !ReadChar(text, pos, '-')) || !ReadDigits(text, pos, 2, offsetH) ||
+            !ReadChar(text, pos, ':') || !ReadDigits(text, pos, 2, offsetMi) || offsetH > 23 || offsetMi > 59) {
+            return std::nullopt;
+        }
+        offset = std::chrono::hours{offsetH} + std::chrono::minutes{offsetMi};
+        if (negative) {
+            offset = -offset;
+        }
+    }
+    if (pos != text.size()) {
+        return std::nullopt;
+    }
+
+    const std::chrono::year_month_day date{
+        std::chrono::year{static_cast<int>(y)}, std::chrono::month{mo}, std::chrono::day{d}};
+    if (!date.ok()) {
+        return std::nullopt;
+    }
+    // Local wall-clock time minus its offset from UTC
+    return std::chrono::sys_days{date} + std::chrono::hours{h} + std::chrono::minutes{mi} + std::chrono::seconds{sec} -
+           offset;
+}
+
 }  // namespace
 
 void DataStore::LoadData(const fs::path& dataDir) {
@@ -44,6 +174,9 @@ void DataStore::LoadData(const fs::path& dataDir) {
         throw std::runtime_error("Failed to load " + std::string(kMoviesFile));
     }
 
+    // Shows point into the theater map, so they go first
+    ClearShows();
+
     mapMovies.clear();
     for (const auto& item : *moviesJson) {
         if (!item.contains("id") || !item.contains("title")) {
@@ -78,9 +211,9 @@ void DataStore::LoadData(const fs::path& dataDir) {
             continue;
         }
 
-        t.seats.reserve(static_cast<std::size_t>(capacity));
-        for (int i = 1; i <= capacity; ++i) {
-            t.seats.push_back(Seat{"a" + std::to_string(i), false});
+        if (!ParseSeatLayout(item, capacity, t)) {
+            std::cerr << "[DataStore] Theater " << t.id << " has invalid seat layout, skipping\n";
+            continue;
         }
         mapTheaters.emplace(t.id, std::move(t));
     }
@@ -90,6 +223,10 @@ void DataStore::LoadData(const fs::path& dataDir) {
         throw std::runtime_error("Failed to load " + std::string(kMappingsFile));
     }
 
+    // Per-show price overrides by seat class name and showtimes, keyed by (movieId, theaterId)
+    std::map<std::pair<int, int>, std::map<std::string, std::int64_t>> showPrices;
+    std::map<std::pair<int, int>, std::vector<std::chrono::sys_seconds>> showTimes;
+
     mapMovieTheaters.clear();
     for (auto& [movieIdStr, theaterIds] : mappingsJson->items()) {
         int movieId = 0;
@@ -109,14 +246,52 @@ void DataStore::LoadData(const fs::path& dataDir) {
         std::vector<int> tids;
         if (theaterIds.is_array()) {
             tids.reserve(theaterIds.size());
-            for (const auto& tid : theaterIds) {
-                int theaterId = tid.get<int>();
+            for (const auto& entry : theaterIds) {
+                // An entry is either a plain theater id or
+                // {"theaterId": ..., "prices": {"<class>": ...}, "showtimes": ["<time>", ...]}
+                if (entry.is_object() && !entry.contains("theaterId")) {
+                    std::cerr << "[DataStore] Mapping for movie " << movieId << " without theaterId – skipping\n";
+                    continue;
+                }
+                const int theaterId = entry.is_object() ? entry["theaterId"].get<int>() : entry.get<int>();
                 if (!mapTheaters.contains(theaterId)) {
                     std::cerr << "[DataStore] Mapping movie " << movieId << " to unknown theaterId " << theaterId
                               << " – skipping this theater\n";
                     continue;
                 }
-                tids.push_back(theaterId);
+                if (entry.is_object() && entry.contains("prices")) {
+                    const auto& seatClasses = mapTheaters.at(theaterId).seatClasses;
+                    auto& prices = showPrices[{movieId, theaterId}];
+                    for (const auto& [className, price] : entry["prices"].items()) {
+                        if (std::ranges::find(seatClasses, className, &SeatClass::name) == seatClasses.end()) {
+                            std::cerr << "[DataStore] Price for unknown seat class " << className << " of movie "
+                                      << movieId << " in theater " << theaterId << " – skipping\n";
+                            continue;
+                        }
+                        const auto value = price.get<std::int64_t>();
+                        if (value < 0) {
+                            std::cerr << "[DataStore] Negative price " << value << " for seat class " << className
+                                      << " of movie " << movieId << " in theater " << theaterId << " – skipping\n";
+                            continue;
+                        }
+                        prices[className] = value;
+                    }
+                }
+                if (entry.is_object() && entry.contains("showtimes")) {
+                    auto& times = showTimes[{movieId, theaterId}];
+                    for (const auto& showtime : entry["showtimes"]) {
+                        const auto startTime = ParseShowtime(showtime);
+                        if (!startTime) {
+                            std::cerr << "[DataStore] Invalid showtime " << showtime << " for movie " << movieId
+                                      << " in theater " << theaterId << " – skipping\n";
+                            continue;
+                        }
+                        times.push_back(*startTime);
+                    }
+                }
+                if (std::ranges::find(tids, theaterId) == tids.end()) {
+                    tids.push_back(theaterId);
+                }
             }
         }
 
@@ -125,7 +300,8 @@ void DataStore::LoadData(const fs::path& dataDir) {
         }
     }
 
-    mapShows.clear();
+    BuildSeatIndexes();
+
     for (const auto& [movieId, theaterIds] : mapMovieTheaters) {
         for (const int tid : theaterIds) {
             auto it = mapTheaters.find(tid);
@@ -134,11 +310,98 @@ void DataStore::LoadData(const fs::path& dataDir) {
                 continue;
             }
 
-            auto show = std::make_unique<Show>();
-            show->seats = it->second.seats;
-            mapShows.emplace(std::make_pair(movieId, tid), std::move(show));
+            const Theater& theater = it->second;
+            std::vector<std::int64_t> classPrices;
+            classPrices.reserve(theater.seatClasses.size());
+            const auto overrides = showPrices.find({movieId, tid});
+            for (const auto& seatClass : theater.seatClasses) {
+                std::int64_t price = seatClass.price;
+                if (overrides != showPrices.end()) {
+                    if (auto pit = overrides->second.find(seatClass.name); pit != overrides->second.end()) {
+                        price = pit->second;
+                    }
+                }
+                classPrices.push_back(price);
+            }
+
+            // Mappings without showtimes get a single unscheduled screening
+            auto tit = showTimes.find({movieId, tid});
+            if (tit == showTimes.end() || tit->second.empty()) {
+                AddShow(movieId, tid, std::nullopt, std::move(classPrices));
+                continue;
+            }
+
+            auto& times = tit->second;
+            std::ranges::sort(times);
+            times.erase(std::unique(times.begin(), times.end()), times.end());
+            for (const auto startTime : times) {
+                AddShow(movieId, tid, startTime, classPrices);
+            }
+        }
+    }
+
+    BuildScheduleAndSearchIndexes();
+}
+
+void DataStore::BuildSeatIndexes() {
+    mapSeatIndex.clear();
+    for (const auto& [tid, theater] : mapTheaters) {
+        auto& seatIndex = mapSeatIndex[tid];
+        seatIndex.reserve(theater.seats.size());
+        for (std::uint32_t i = 0; i < theater.seats.size(); ++i) {
+            seatIndex.emplace(theater.seats[i].id, i);
+        }
+    }
+}
+
+void DataStore::ClearShows() {
+    shows.clear();
+    mapShows.clear();
+    movieSchedules.clear();
+    theaterSchedules.clear();
+}
+
+DataStore::Show& DataStore::AddShow(int movieId,
+                                    int theaterId,
+                                    std::optional<std::chrono::sys_seconds> startTime,
+                                    std::vector<std::int64_t> classPrices) {
+    const Theater& theater = mapTheaters.at(theaterId);
+
+    auto show = std::make_unique<Show>();
+    show->screening = Screening{static_cast<int>(shows.size()), movieId, theaterId, startTime};
+    show->theater = &theater;
+    show->seatIndex = &mapSeatIndex.at(theaterId);
+    show->classPrices = std::move(classPrices);
+    show->seatState = MakeSeatState(static_cast<std::uint32_t>(theater.seats.size()));
+
+    mapShows.emplace(std::make_pair(movieId, theaterId), show->screening.id);
+    if (startTime) {
+        movieSchedules[movieId].push_back({*startTime, show->screening.id});
+        theaterSchedules[theaterId].push_back({*startTime, show->screening.id});
+    }
+    shows.push_back(std::move(show));
+    return *shows.back();
+}
+
+void DataStore::BuildScheduleAndSearchIndexes() {
+    for (auto* schedules : {&movieSchedules, &theaterSchedules}) {
+        for (auto& schedule : *schedules | std::views::values) {
+            std::ranges::sort(schedule);
+            schedule.shrink_to_fit();
         }
     }
+
+    movieSearch.Clear();
+    for (const auto& [id, movie] : mapMovies) {
+        movieSearch.Add(id, movie.title);
+    }
+    movieSearch.Build();
+
+    theaterSearch.Clear();
+    for (const auto& [id, theater] : mapTheaters) {
+        theaterSearch.Add(id, theater.name);
+    }
+    theaterSearch.Build();
 }
 
 std::vector<Movie> DataStore::GetMovies() const {
@@ -170,50 +433,542 @@ std::optional<Theater> DataStore::GetTheater(int theaterId) const {
     return std::nullopt;
 }
 
-bool DataStore::BookSeats(int theaterId, int movieId, const std::vector<std::string>& seatIds) {
-    if (seatIds.empty()) {
-        return false;
+std::vector<int> DataStore::SearchMovies(std::string_view query, std::size_t limit) const {
+    return movieSearch.Search(query, limit);
+}
+
+std::vector<int> DataStore::SearchTheaters(std::string_view query, std::size_t limit) const {
+    return theaterSearch.Search(query, limit);
+}
+
+std::optional<Screening> DataStore::GetScreening(int screeningId) const {
+    if (screeningId < 0 || static_cast<std::size_t>(screeningId) >= shows.size()) {
+        return std::nullopt;
     }
+    return shows[screeningId]->screening;
+}
 
+std::optional<Screening> DataStore::GetScreening(int theaterId, int movieId) const {
     auto it = mapShows.find({movieId, theaterId});
     if (it == mapShows.end()) {
-        return false;
+        return std::nullopt;
     }
+    return shows[it->second]->screening;
+}
 
-    auto& show = *it->second;
-    std::lock_guard lock(show.mtx);
+std::vector<Screening> DataStore::GetScreenings(int movieId,
+                                                std::chrono::sys_seconds from,
+                                                std::chrono::sys_seconds to) const {
+    return CollectScreenings(movieSchedules, movieId, from, to);
+}
 
-    std::vector<Seat*> seatsToBook;
-    seatsToBook.reserve(seatIds.size());
+std::vector<Screening> DataStore::GetTheaterScreenings(int theaterId,
+                                                       std::chrono::sys_seconds from,
+                                                       std::chrono::sys_seconds to) const {
+    return CollectScreenings(theaterSchedules, theaterId, from, to);
+}
+
+std::vector<Screening> DataStore::CollectScreenings(const std::map<int, Schedule>& schedules,
+                                                    int key,
+                                                    std::chrono::sys_seconds from,
+                                                    std::chrono::sys_seconds to) const {
+    std::vector<Screening> result;
+    auto it = schedules.find(key);
+    if (it == schedules.end() || from >= to) {
+        return result;
+    }
+
+    const Schedule& schedule = it->second;
+    const auto first = std::ranges::lower_bound(schedule, from, {}, &ScheduleEntry::startTime);
+    const auto last = std::ranges::lower_bound(first, schedule.end(), to, {}, &ScheduleEntry::startTime);
+    result.reserve(static_cast<std::size_t>(last - first));
+    for (auto entry = first; entry != last; ++entry) {
+        result.push_back(shows[entry->screeningId]->screening);
+    }
+    return result;
+}
+
+BookingResult DataStore::BookSeats(int theaterId, int movieId, const std::vector<std::string>& seatIds) {
+    auto it = mapShows.find({movieId, theaterId});
+    if (it == mapShows.end()) {
+        return {};
+    }
+    return BookShowSeats(*shows[it->second], seatIds);
+}
+
+BookingResult DataStore::BookSeats(int screeningId, const std::vector<std::string>& seatIds) {
+    if (screeningId < 0 || static_cast<std::size_t>(screeningId) >= shows.size()) {
+        return {};
+    }
+    return BookShowSeats(*shows[screeningId], seatIds);
+}
+
+DataStore::Show* DataStore::FindShow(int screeningId) {
+    if (screeningId < 0 || static_cast<std::size_t>(screeningId) >= shows.size()) {
+        return nullptr;
+    }
+    return shows[screeningId].get();
+}
+
+DataStore::Show* DataStore::FindShow(int theaterId, int movieId) {
+    auto it = mapShows.find({movieId, theaterId});
+    return it == mapShows.end() ? nullptr : shows[it->second].get();
+}
+
+std::optional<BookingStatus> DataStore::ResolveSeats(const Show& show,
+                                                     const std::vector<std::string>& seatIds,
+                                                     std::vector<std::uint32_t>& seatsToBook) {
+    if (seatIds.empty()) {
+        return BookingStatus::Rejected;
+    }
+
+    // Bookings are never cancelled, so a full show is refused from its counter alone
+    const auto capacity = show.theater->seats.size();
+    const auto booked = static_cast<std::size_t>(show.bookedSeats.load(std::memory_order_relaxed));
+    if (booked >= capacity) {
+        return BookingStatus::SoldOut;
+    }
 
+    // Seat ids are resolved against the immutable layout before taking the lock
+    seatsToBook.reserve(seatIds.size());
     for (const auto& seatId : seatIds) {
-        auto seatIt = std::ranges::find_if(show.seats, [&seatId](const auto& seat) { return seat.id == seatId; });
+        auto seatIt = show.seatIndex->find(seatId);
+        if (seatIt == show.seatIndex->end()) {
+            return BookingStatus::Rejected;
+        }
+        seatsToBook.push_back(seatIt->second);
+    }
+    std::ranges::sort(seatsToBook);
+    seatsToBook.erase(std::unique(seatsToBook.begin(), seatsToBook.end()), seatsToBook.end());
+    if (booked + seatsToBook.size() > capacity) {
+        return BookingStatus::Rejected;
+    }
+    return std::nullopt;
+}
 
-        if (seatIt == show.seats.end()) {
-            return false;
+BookingResult DataStore::BookShowSeats(Show& show, const std::vector<std::string>& seatIds) {
+    std::vector<std::uint32_t> seatsToBook;
+    if (const auto decided = ResolveSeats(show, seatIds, seatsToBook)) {
+        return {*decided};
+    }
+
+    int bookedBefore = 0;
+    BookingStatus status = BookingStatus::Rejected;
+    if (admissionPolicy.combineBookings) {
+        status = BookQueued(show, seatsToBook, bookedBefore);
+    }
+    else {
+        std::unique_lock lock(show.mtx);
+        status = ApplyBooking(show, seatsToBook, bookedBefore);
+        ReleaseShow(show, lock, true);
+    }
+    if (status != BookingStatus::Booked) {
+        return {status};
+    }
+    return PriceBooking(show, seatsToBook, bookedBefore);
+}
+
+BookingResult DataStore::PriceBooking(const Show& show,
+                                      const std::vector<std::uint32_t>& seatsToBook,
+                                      int bookedBefore) const {
+    // Pricing runs outside the lock: seat classes and price tables never change after loading.
+    const Screening& screening = show.screening;
+    BookingResult result{BookingStatus::Booked, 0};
+    for (const auto seat : seatsToBook) {
+        const std::uint16_t seatClass = show.theater->seats[seat].seatClass;
+        const std::int64_t basePrice = show.classPrices[seatClass];
+        if (pricingPolicy) {
+            const PricingContext context{screening.id,
+                                         screening.movieId,
+                                         screening.theaterId,
+                                         screening.startTime,
+                                         seatClass,
+                                         static_cast<int>(show.theater->seats.size()),
+                                         bookedBefore};
+            result.totalPrice += pricingPolicy(basePrice, context);
+        }
+        else {
+            result.totalPrice += basePrice;
+        }
+    }
+    return result;
+}
+
+BookingStatus DataStore::BookQueued(Show& show, const std::vector<std::uint32_t>& seatsToBook, int& bookedBefore) {
+    PendingOp op;
+    op.seats = &seatsToBook;
+
+    std::unique_lock queueLock(show.queueMtx);
+    if (show.pendingBookings >= admissionPolicy.maxQueuedBookings) {
+        return BookingStatus::Overloaded;
+    }
+    ++show.pendingBookings;
+    show.queue.push_back(&op);
+    if (show.combining) {
+        // Parks on the state word; the combiner notifies while holding queueMtx, so relocking
+        // here guarantees it no longer touches this op once we return
+        queueLock.unlock();
+        op.state.wait(PendingOp::State::Waiting);
+        queueLock.lock();
+        if (op.state.load() == PendingOp::State::Done) {
+            bookedBefore = op.bookedBefore;
+            return op.status;
         }
-        if (seatIt->isBooked) {
+    }
+
+    show.combining = true;
+    std::unique_lock showLock(show.mtx, std::defer_lock);
+    CombinePending(show, queueLock, showLock);
+    bookedBefore = op.bookedBefore;
+    return op.status;
+}
+
+bool DataStore::SuspendQueued(Show& show, PendingOp& op) {
+    std::unique_lock queueLock(show.queueMtx);
+    if (op.seats) {
+        if (show.pendingBookings >= admissionPolicy.maxQueuedBookings) {
+            op.status = BookingStatus::Overloaded;
             return false;
         }
-        seatsToBook.push_back(&(*seatIt));
+        ++show.pendingBookings;
     }
+    show.queue.push_back(&op);
+
+    // Nobody is applying the queue and the show lock is free: apply one batch here, before the
+    // coroutine would have suspended. Otherwise leave the request to whoever holds either.
+    std::unique_lock showLock(show.mtx, std::defer_lock);
+    if (show.combining || !TryLockShow(show, showLock)) {
+        // Set under queueMtx: once it is released the op may be applied and the coroutine resumed
+        // (and its frame freed) on another thread
+        op.queued = true;
+        return true;
+    }
+    op.executor = nullptr;
+    show.combining = true;
+    CombineOnce(show, queueLock, showLock);
+    return false;
+}
 
-    for (auto* seat : seatsToBook) {
-        seat->isBooked = true;
+void DataStore::WithdrawQueued(Show& show, PendingOp& op) {
+    std::unique_lock queueLock(show.queueMtx);
+    if (op.state.load() == PendingOp::State::Done) {
+        return;
     }
+    if (auto it = std::ranges::find(show.queue, &op); it != show.queue.end()) {
+        show.pendingBookings -= op.seats != nullptr;
+        show.queue.erase(it);
+        return;
+    }
+    // Already in the batch being applied; the combiner is done with it once it is marked Done
+    // and queueMtx is released
+    queueLock.unlock();
+    op.state.wait(PendingOp::State::Waiting);
+    queueLock.lock();
+}
 
+bool DataStore::TryLockShow(Show& show, std::unique_lock<std::mutex>& showLock) {
+    if (showLock.try_lock()) {
+        return true;
+    }
+    // The holder is a reader or an uncombined booking; it applies the queue once it unlocks
+    // (see ReleaseShow). The second attempt covers a holder that unlocked before the flag was set.
+    show.stranded.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!showLock.try_lock()) {
+        return false;
+    }
+    show.stranded.store(false, std::memory_order_relaxed);
     return true;
 }
 
+void DataStore::ReleaseShow(Show& show, std::unique_lock<std::mutex>& showLock, bool mayBlock) {
+    showLock.unlock();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!show.stranded.load(std::memory_order_relaxed) || !show.stranded.exchange(false)) {
+        return;
+    }
+    std::unique_lock queueLock(show.queueMtx);
+    if (show.combining || show.queue.empty()) {
+        return;
+    }
+    if (mayBlock) {
+        show.combining = true;
+        CombinePending(show, queueLock, showLock);
+    }
+    else if (TryLockShow(show, showLock)) {
+        show.combining = true;
+        CombineOnce(show, queueLock, showLock);
+    }
+}
+
+void DataStore::DrainQueued(Show& show) {
+    std::unique_lock queueLock(show.queueMtx);
+    if (show.combining || show.queue.empty()) {
+        return;
+    }
+    std::unique_lock showLock(show.mtx, std::defer_lock);
+    if (TryLockShow(show, showLock)) {
+        show.combining = true;
+        CombineOnce(show, queueLock, showLock);
+    }
+}
+
+void DataStore::CombinePending(Show& show,
+                               std::unique_lock<std::mutex>& queueLock,
+                               std::unique_lock<std::mutex>& showLock) {
+    // A blocked thread owns the role: it keeps applying the queue while only coroutines are
+    // waiting, since it has nothing else to do
+    do {
+        ApplyBatch(show, queueLock, showLock);
+    } while (!HandOff(show));
+}
+
+void DataStore::CombineOnce(Show& show,
+                            std::unique_lock<std::mutex>& queueLock,
+                            std::unique_lock<std::mutex>& showLock) {
+    // A thread that must not block (an event loop) applies a single batch. Whatever coroutines
+    // queued meanwhile are drained from the oldest one's executor; the role is released first,
+    // so a blocking caller or a new request can still pick the queue up before that runs.
+    ApplyBatch(show, queueLock, showLock);
+    if (HandOff(show)) {
+        return;
+    }
+    show.combining = false;
+    show.queue.front()->executor->Post([&show]() { DrainQueued(show); });
+}
+
+void DataStore::ApplyBatch(Show& show,
+                           std::unique_lock<std::mutex>& queueLock,
+                           std::unique_lock<std::mutex>& showLock) {
+    // The caller owns the combiner role and holds queueLock. Everything queued so far is applied
+    // in arrival order under one show lock acquisition; the vectors are swapped rather than moved
+    // so neither reallocates once warmed up.
+    show.batch.swap(show.queue);
+    queueLock.unlock();
+    if (!showLock.owns_lock()) {
+        showLock.lock();
+    }
+    for (auto* op : show.batch) {
+        if (op->seats) {
+            op->status = ApplyBooking(show, *op->seats, op->bookedBefore);
+        }
+        else {
+            op->seatState = show.seatState;
+        }
+    }
+    showLock.unlock();
+    queueLock.lock();
+
+    for (auto* op : show.batch) {
+        show.pendingBookings -= op->seats != nullptr;
+        op->state.store(PendingOp::State::Done);
+        op->state.notify_one();
+        if (op->executor) {
+            op->executor->Post(op->continuation);  // calling a coroutine handle resumes it
+        }
+    }
+    show.batch.clear();
+}
+
+bool DataStore::HandOff(Show& show) {
+    if (show.queue.empty()) {
+        show.combining = false;
+        return true;
+    }
+    // Handing the role to the oldest blocked thread keeps one thread from serving everyone else
+    // indefinitely. Coroutines are never handed it, so the show never waits for an executor.
+    auto next = std::ranges::find(show.queue, nullptr, &PendingOp::executor);
+    if (next == show.queue.end()) {
+        return false;
+    }
+    (*next)->state.store(PendingOp::State::Combine);
+    (*next)->state.notify_one();
+    return true;
+}
+
+BookingStatus DataStore::ApplyBooking(Show& show, const std::vector<std::uint32_t>& seatsToBook, int& bookedBefore) {
+    const int booked = show.bookedSeats.load(std::memory_order_relaxed);
+    const bool applied = std::visit(
+        [&seatsToBook](auto& seatState) {
+            for (const auto seat : seatsToBook) {
+                if (seatState.IsBooked(seat)) {
+                    return false;
+                }
+            }
+            for (const auto seat : seatsToBook) {
+                seatState.Book(seat);
+            }
+            return true;
+        },
+        show.seatState);
+    if (!applied) {
+        const bool soldOut = static_cast<std::size_t>(booked) == show.theater->seats.size();
+        return soldOut ? BookingStatus::SoldOut : BookingStatus::Rejected;
+    }
+
+    bookedBefore = booked;
+    show.bookedSeats.store(booked + static_cast<int>(seatsToBook.size()), std::memory_order_relaxed);
+    show.version.store(show.version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return BookingStatus::Booked;
+}
+
+void DataStore::SetPricingPolicy(PricingPolicy policy) {
+    pricingPolicy = std::move(policy);
+}
+
+void DataStore::SetAdmissionPolicy(AdmissionPolicy policy) {
+    if (policy.maxQueuedBookings == 0) {
+        throw std::invalid_argument("AdmissionPolicy::maxQueuedBookings must be positive");
+    }
+    admissionPolicy = policy;
+}
+
+std::optional<std::uint64_t> DataStore::GetVersion(int screeningId) const {
+    if (screeningId < 0 || static_cast<std::size_t>(screeningId) >= shows.size()) {
+        return std::nullopt;
+    }
+    return shows[screeningId]->version.load(std::memory_order_relaxed);
+}
+
 std::vector<Seat> DataStore::GetSeats(int theaterId, int movieId) const {
     auto it = mapShows.find({movieId, theaterId});
     if (it == mapShows.end()) {
         return {};
     }
+    return CopyShowSeats(*shows[it->second]);
+}
+
+std::vector<Seat> DataStore::GetSeats(int screeningId) const {
+    if (screeningId < 0 || static_cast<std::size_t>(screeningId) >= shows.size()) {
+        return {};
+    }
+    return CopyShowSeats(*shows[screeningId]);
+}
+
+std::vector<Seat> DataStore::CopyShowSeats(Show& show) const {
+    std::unique_lock lock(show.mtx);
+    SeatState seatState = show.seatState;
+    ReleaseShow(show, lock, true);
+    return BuildSeats(show, seatState);
+}
+
+std::vector<Seat> DataStore::BuildSeats(const Show& show, const SeatState& seatState) {
+    std::vector<Seat> seats = show.theater->seats;
+    std::visit(
+        [&seats](const auto& state) {
+            for (std::uint32_t i = 0; i < seats.size(); ++i) {
+                seats[i].isBooked = state.IsBooked(i);
+            }
+        },
+        seatState);
+    return seats;
+}
+
+std::vector<std::string> DataStore::FindFreeSeats(int screeningId, std::size_t count) const {
+    if (screeningId < 0 || static_cast<std::size_t>(screeningId) >= shows.size()) {
+        return {};
+    }
+
+    Show& show = *shows[screeningId];
+    std::vector<std::uint32_t> freeSeats;
+    freeSeats.reserve(std::min(count, show.theater->seats.size()));
+    std::unique_lock lock(show.mtx);
+    std::visit([&](const auto& seatState) { seatState.FindFree(count, freeSeats); }, show.seatState);
+    ReleaseShow(show, lock, true);
+
+    std::vector<std::string> seatIds;
+    seatIds.reserve(freeSeats.size());
+    for (const auto seat : freeSeats) {
+        seatIds.push_back(show.theater->seats[seat].id);
+    }
+    return seatIds;
+}
+
+DataStore::BookingAwaiter DataStore::BookSeatsAsync(int screeningId,
+                                                    const std::vector<std::string>& seatIds,
+                                                    Executor& executor) {
+    return BookingAwaiter(*this, FindShow(screeningId), seatIds, executor);
+}
+
+DataStore::BookingAwaiter DataStore::BookSeatsAsync(int theaterId,
+                                                    int movieId,
+                                                    const std::vector<std::string>& seatIds,
+                                                    Executor& executor) {
+    return BookingAwaiter(*this, FindShow(theaterId, movieId), seatIds, executor);
+}
+
+DataStore::SeatsAwaiter DataStore::GetSeatsAsync(int screeningId, Executor& executor) {
+    return SeatsAwaiter(*this, FindShow(screeningId), executor);
+}
+
+DataStore::SeatsAwaiter DataStore::GetSeatsAsync(int theaterId, int movieId, Executor& executor) {
+    return SeatsAwaiter(*this, FindShow(theaterId, movieId), executor);
+}
+
+DataStore::BookingAwaiter::BookingAwaiter(DataStore& store,
+                                          Show* show,
+                                          const std::vector<std::string>& seatIds,
+                                          Executor& executor)
+    : store(store)
+    , show(show) {
+    decided = show ? ResolveSeats(*show, seatIds, seatsToBook) : BookingStatus::Rejected;
+    op.seats = &seatsToBook;
+    op.executor = &executor;
+}
+
+DataStore::BookingAwaiter::~BookingAwaiter() {
+    if (op.queued) {
+        WithdrawQueued(*show, op);
+    }
+}
+
+bool DataStore::BookingAwaiter::await_suspend(std::coroutine_handle<> continuation) {
+    op.continuation = continuation;
+    return store.SuspendQueued(*show, op);
+}
+
+BookingResult DataStore::BookingAwaiter::await_resume() const {
+    if (decided) {
+        return {*decided};
+    }
+    if (op.status != BookingStatus::Booked) {
+        return {op.status};
+    }
+    return store.PriceBooking(*show, seatsToBook, op.bookedBefore);
+}
+
+DataStore::SeatsAwaiter::SeatsAwaiter(DataStore& store, Show* show, Executor& executor)
+    : store(store)
+    , show(show) {
+    op.executor = &executor;
+}
+
+DataStore::SeatsAwaiter::~SeatsAwaiter() {
+    if (op.queued) {
+        WithdrawQueued(*show, op);
+    }
+}
+
+bool DataStore::SeatsAwaiter::await_ready() {
+    if (!show) {
+        return true;
+    }
+    std::unique_lock lock(show->mtx, std::try_to_lock);
+    if (!lock) {
+        return false;
+    }
+    op.seatState = show->seatState;
+    ReleaseShow(*show, lock, false);
+    return true;
+}
+
+bool DataStore::SeatsAwaiter::await_suspend(std::coroutine_handle<> continuation) {
+    op.continuation = continuation;
+    return store.SuspendQueued(*show, op);
+}
 
-    auto& show = *it->second;
-    std::lock_guard lock(show.mtx);
-    return show.seats;
+std::vector<Seat> DataStore::SeatsAwaiter::await_resume() const {
+    return show ? BuildSeats(*show, op.seatState) : std::vector<Seat>{};
 }
 
 }  // namespace booking_service
@@ -0,0 +1,321 @@
+#include "DataStore.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace booking_service {
+
+namespace {
+
+// Layout (integers in host byte order):
+//   header  magic, format version
+//   movies  count, {id, title}
+//   theaters count, {id, name, classes {name, price}, seats {id, class}}
+//   mappings count, {movieId, theaterIds}
+//   shows   count, {movieId, theaterId, scheduled, startTime, prices, version, bookedSeats, bitmap words}
+//   trailer magic
+constexpr std::string_view kSnapshotMagic = "BKSNAP01";
+constexpr std::string_view kSnapshotTrailer = "BKSNAPND";
+constexpr std::uint32_t kSnapshotFormat = 2;
+constexpr std::size_t kIoBufferSize = 1 << 20;
+
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(const fs::path& file) {
+        out.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.open(file, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Failed to open snapshot for writing: " + file.string());
+        }
+    }
+
+    template <class T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void WriteString(std::string_view text) {
+        Write(static_cast<std::uint32_t>(text.size()));
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    template <class T>
+    void WriteArray(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(static_cast<std::uint32_t>(values.size()));
+        const auto bytes = static_cast<std::streamsize>(values.size() * sizeof(T));
+        out.write(reinterpret_cast<const char*>(values.data()), bytes);
+    }
+
+    void WriteRaw(std::string_view bytes) { out.write(bytes.data(), static_cast<std::streamsize>(bytes.size())); }
+
+    void Finish() {
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Failed to write snapshot");
+        }
+    }
+
+private:
+    std::vector<char> buffer = std::vector<char>(kIoBufferSize);
+    std::ofstream out;
+};
+
+/**
+ * Reads the whole snapshot into memory and parses it with bounds checks.
+ */
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const fs::path& file) {
+        std::ifstream in(file, std::ios::binary | std::ios::ate);
+        if (!in.is_open()) {
+            throw std::runtime_error("Failed to open snapshot: " + file.string());
+        }
+        data.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!in) {
+            throw std::runtime_error("Failed to read snapshot: " + file.string());
+        }
+    }
+
+    template <class T>
+    T Read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string ReadString() {
+        const auto size = Read<std::uint32_t>();
+        return std::string(Take(size), size);
+    }
+
+    template <class T>
+    std::vector<T> ReadArray() {
+        const auto size = Read<std::uint32_t>();
+        const char* bytes = Take(size * sizeof(T));
+        std::vector<T> values(size);
+        if (size > 0) {
+            std::memcpy(values.data(), bytes, size * sizeof(T));
+        }
+        return values;
+    }
+
+    void Expect(std::string_view bytes) {
+        if (std::string_view(Take(bytes.size()), bytes.size()) != bytes) {
+            throw std::runtime_error("Corrupted snapshot: bad marker");
+        }
+    }
+
+    /**
+     * Reads an element count and checks that at least minBytes per element remain, so corrupted
+     * counts fail cleanly instead of triggering huge allocations.
+     */
+    std::uint32_t ReadCount(std::size_t minBytes) {
+        const auto count = Read<std::uint32_t>();
+        if (count > (data.size() - pos) / minBytes) {
+            throw std::runtime_error("Corrupted snapshot: count exceeds file size");
+        }
+        return count;
+    }
+
+    bool AtEnd() const { return pos == data.size(); }
+
+private:
+    const char* Take(std::size_t size) {
+        if (size > data.size() - pos) {
+            throw std::runtime_error("Corrupted snapshot: unexpected end of file");
+        }
+        const char* ptr = data.data() + pos;
+        pos += size;
+        return ptr;
+    }
+
+    std::vector<char> data;
+    std::size_t pos = 0;
+};
+
+}  // namespace
+
+void DataStore::ExportSnapshot(const fs::path& file) const {
+    SnapshotWriter writer(file);
+    writer.WriteRaw(kSnapshotMagic);
+    writer.Write(kSnapshotFormat);
+
+    // The catalog never changes after loading, so it is written without locks
+    writer.Write(static_cast<std::uint64_t>(mapMovies.size()));
+    for (const auto& [id, movie] : mapMovies) {
+        writer.Write(id);
+        writer.WriteString(movie.title);
+    }
+
+    writer.Write(static_cast<std::uint64_t>(mapTheaters.size()));
+    for (const auto& [id, theater] : mapTheaters) {
+        writer.Write(id);
+        writer.WriteString(theater.name);
+        writer.Write(static_cast<std::uint32_t>(theater.seatClasses.size()));
+        for (const auto& seatClass : theater.seatClasses) {
+            writer.WriteString(seatClass.name);
+            writer.Write(seatClass.price);
+        }
+        writer.Write(static_cast<std::uint32_t>(theater.seats.size()));
+        for (const auto& seat : theater.seats) {
+            writer.WriteString(seat.id);
+            writer.Write(seat.seatClass);
+        }
+    }
+
+    writer.Write(static_cast<std::uint64_t>(mapMovieTheaters.size()));
+    for (const auto& [movieId, theaterIds] : mapMovieTheaters) {
+        writer.Write(movieId);
+        writer.WriteArray(theaterIds);
+    }
+
+    // Each show is locked only while its state is copied; the file is written outside the lock
+    writer.Write(static_cast<std::uint64_t>(shows.size()));
+    std::vector<std::uint64_t> bookedBits;
+    for (const auto& show : shows) {
+        std::uint64_t version = 0;
+        int bookedSeats = 0;
+        {
+            std::unique_lock lock(show->mtx);
+            bookedBits = std::visit([](const auto& seatState) { return seatState.Bitmap(); }, show->seatState);
+            version = show->version.load(std::memory_order_relaxed);
+            bookedSeats = show->bookedSeats.load(std::memory_order_relaxed);
+            ReleaseShow(*show, lock, true);
+        }
+
+        const Screening& screening = show->screening;
+        writer.Write(screening.movieId);
+        writer.Write(screening.theaterId);
+        const auto startTime = screening.startTime.value_or(std::chrono::sys_seconds{});
+        writer.Write(static_cast<std::uint8_t>(screening.startTime.has_value()));
+        writer.Write(static_cast<std::int64_t>(startTime.time_since_epoch().count()));
+        writer.WriteArray(show->classPrices);
+        writer.Write(version);
+        writer.Write(bookedSeats);
+        writer.WriteArray(bookedBits);
+    }
+
+    writer.WriteRaw(kSnapshotTrailer);
+    writer.Finish();
+}
+
+void DataStore::ImportSnapshot(const fs::path& file) {
+    // A bad file throws while the scratch store is being filled, before this store is touched
+    DataStore imported;
+    imported.ReadSnapshot(file);
+    SwapData(imported);
+}
+
+void DataStore::SwapData(DataStore& other) noexcept {
+    // Node-based containers keep their elements in place when swapped, so the shows' pointers
+    // into mapTheaters and mapSeatIndex stay valid
+    std::swap(mapMovies, other.mapMovies);
+    std::swap(mapMovieTheaters, other.mapMovieTheaters);
+    std::swap(mapTheaters, other.mapTheaters);
+    std::swap(mapSeatIndex, other.mapSeatIndex);
+    std::swap(shows, other.shows);
+    std::swap(mapShows, other.mapShows);
+    std::swap(movieSchedules, other.movieSchedules);
+    std::swap(theaterSchedules, other.theaterSchedules);
+    std::swap(movieSearch, other.movieSearch);
+    std::swap(theaterSearch, other.theaterSearch);
+}
+
+void DataStore::ReadSnapshot(const fs::path& file) {
+    SnapshotReader reader(file);
+    reader.Expect(kSnapshotMagic);
+    if (reader.Read<std::uint32_t>() != kSnapshotFormat) {
+        throw std::runtime_error("Unsupported snapshot format: " + file.string());
+    }
+
+    for (auto count = reader.Read<std::uint64_t>(); count > 0; --count) {
+        const int id = reader.Read<int>();
+        mapMovies.emplace(id, Movie{id, reader.ReadString()});
+    }
+
+    for (auto count = reader.Read<std::uint64_t>(); count > 0; --count) {
+        Theater t;
+        t.id = reader.Read<int>();
+        t.name = reader.ReadString();
+        t.seatClasses.resize(reader.ReadCount(sizeof(std::uint32_t) + sizeof(std::int64_t)));
+        for (auto& seatClass : t.seatClasses) {
+            seatClass.name = reader.ReadString();
+            seatClass.price = reader.Read<std::int64_t>();
+        }
+        t.seats.resize(reader.ReadCount(sizeof(std::uint32_t) + sizeof(std::uint16_t)));
+        for (auto& seat : t.seats) {
+            seat.id = reader.ReadString();
+            seat.seatClass = reader.Read<std::uint16_t>();
+            if (seat.seatClass >= t.seatClasses.size()) {
+                throw std::runtime_error("Corrupted snapshot: seat class out of range");
+            }
+        }
+        if (t.seats.empty()) {
+            throw std::runtime_error("Corrupted snapshot: theater without seats");
+        }
+        mapTheaters.emplace(t.id, std::move(t));
+    }
+
+    for (auto count = reader.Read<std::uint64_t>(); count > 0; --count) {
+        const int movieId = reader.Read<int>();
+        auto theaterIds = reader.ReadArray<int>();
+        if (!mapMovies.contains(movieId) ||
+            !std::ranges::all_of(theaterIds, [this](int id) { return mapTheaters.contains(id); })) {
+            throw std::runtime_error("Corrupted snapshot: mapping does not match the catalog");
+        }
+        mapMovieTheaters.emplace(movieId, std::move(theaterIds));
+    }
+
+    BuildSeatIndexes();
+
+    for (auto count = reader.Read<std::uint64_t>(); count > 0; --count) {
+        const int movieId = reader.Read<int>();
+        const int theaterId = reader.Read<int>();
+        const bool scheduled = reader.Read<std::uint8_t>() != 0;
+        const std::chrono::sys_seconds time{std::chrono::seconds{reader.Read<std::int64_t>()}};
+        const auto startTime = scheduled ? std::optional{time} : std::nullopt;
+        auto classPrices = reader.ReadArray<std::int64_t>();
+        const auto version = reader.Read<std::uint64_t>();
+        const int bookedSeats = reader.Read<int>();
+        auto bookedBits = reader.ReadArray<std::uint64_t>();
+
+        auto theater = mapTheaters.find(theaterId);
+        if (!mapMovies.contains(movieId) || theater == mapTheaters.end() ||
+            classPrices.size() != theater->second.seatClasses.size()) {
+            throw std::runtime_error("Corrupted snapshot: show does not match the catalog");
+        }
+
+        Show& show = AddShow(movieId, theaterId, startTime, std::move(classPrices));
+        if (!std::visit([&bookedBits](auto& seatState) { return seatState.Assign(bookedBits); }, show.seatState)) {
+            throw std::runtime_error("Corrupted snapshot: seat bitmap does not match the theater");
+        }
+        const auto bitCount = std::accumulate(bookedBits.begin(), bookedBits.end(), 0, [](int sum, std::uint64_t word) {
+            return sum + std::popcount(word);
+        });
+        if (bookedSeats != bitCount) {
+            throw std::runtime_error("Corrupted snapshot: booked seat count does not match the bitmap");
+        }
+        show.bookedSeats.store(bookedSeats, std::memory_order_relaxed);
+        show.version.store(version, std::memory_order_relaxed);
+    }
+
+    reader.Expect(kSnapshotTrailer);
+    if (!reader.AtEnd()) {
+        throw std::runtime_error("Corrupted snapshot: trailing data");
+    }
+
+    BuildScheduleAndSearchIndexes();
+}
+
+}  // namespace booking_service
@@ -0,0 +1,315 @@
+#include "SearchIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace booking_service {
+
+namespace {
+
+// Base letters for U+00C0..U+017F. '*' marks letters folded to two ASCII letters, ' ' marks separators.
+constexpr std::string_view kLatinFold = "aaaaaa*ceeeeiiiidnooooo ouuuuy**aaaaaa*ceeeeiiiidnooooo ouuuuy*y"
+                                        "aaaaaaccccccccddddeeeeeeeeeegggggggghhhhiiiiiiiiii**jjkkklllllll"
+                                        "lllnnnnnnnnnoooooo**rrrrrrssssssssttttttuuuuuuuuuuuuwwyyyzzzzzzs";
+
+// Scores per matched query word
+constexpr int kExactWordScore = 4;
+constexpr int kPrefixWordScore = 2;
+constexpr int kLeadingWordScore = 1;
+constexpr std::size_t kMaxQueryWords = 32;
+
+/**
+ * Per-thread query buffers, shared by all indexes. scores and wordScores are all zero between queries.
+ */
+struct SearchScratch {
+    std::vector<std::uint16_t> scores;
+    std::vector<std::uint8_t> wordScores;
+    std::vector<std::uint32_t> touched;
+    std::vector<std::uint32_t> candidates;
+};
+
+thread_local SearchScratch tlsScratch;
+
+/**
+ * Decodes one UTF-8 code point starting at text[pos] and advances pos.
+ * Malformed bytes are returned as U+FFFD.
+ */
+char32_t DecodeUtf8(std::string_view text, std::size_t& pos) {
+    const auto lead = static_cast<unsigned char>(text[pos++]);
+    if (lead < 0x80) {
+        return lead;
+    }
+
+    int extra = 0;
+    char32_t cp = 0;
+    if ((lead & 0xE0) == 0xC0) {
+        extra = 1;
+        cp = lead & 0x1F;
+    }
+    else if ((lead & 0xF0) == 0xE0) {
+        extra = 2;
+        cp = lead & 0x0F;
+    }
+    else if ((lead & 0xF8) == 0xF0) {
+        extra = 3;
+        cp = lead & 0x07;
+    }
+    else {
+        return U'�';
+    }
+
+    for (int i = 0; i < extra; ++i) {
+        if (pos >= text.size() || (static_cast<unsigned char>(text[pos]) & 0xC0) != 0x80) {
+            return U'�';
+        }
+        cp = (cp << 6) | (static_cast<unsigned char>(text[pos++]) & 0x3F);
+    }
+    return cp;
+}
+
+void AppendUtf8(std::string& out, char32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    }
+    else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+    else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+    else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+std::string_view LatinLigature(char32_t cp) {
+    switch (cp) {
+    case U'Æ':
+    case U'æ':
+        return "ae";
+    case U'Þ':
+    case U'þ':
+        return "th";
+    case U'ß':
+        return "ss";
+    case U'Ĳ':
+    case U'ĳ':
+        return "ij";
+    case U'Œ':
+    case U'œ':
+        return "oe";
+    default:
+        return "";
+    }
+}
+
+bool IsSeparator(char32_t cp) {
+    if (cp < 0x80) {
+        return !((cp >= 'a' && cp <= 'z') || (cp >= '0' && cp <= '9'));
+    }
+    // Latin-1 punctuation, general punctuation and replacement characters
+    return cp < 0xC0 || (cp >= 0x2000 && cp <= 0x206F) || cp == U'�';
+}
+
+}  // namespace
+
+std::string SearchIndex::Fold(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        char32_t cp = DecodeUtf8(text, pos);
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp >= 'A' && cp <= 'Z' ? cp + ('a' - 'A') : cp));
+            continue;
+        }
+        if (cp >= 0xC0 && cp < 0x180) {
+            const char base = kLatinFold[cp - 0xC0];
+            if (base == '*') {
+                out += LatinLigature(cp);
+            }
+            else {
+                out.push_back(base);
+            }
+            continue;
+        }
+
+        if (cp >= 0x410 && cp <= 0x42F) {
+            cp += 0x20;  // А..Я → а..я
+        }
+        else if (cp >= 0x400 && cp <= 0x40F) {
+            cp += 0x50;  // Ѐ..Џ → ѐ..џ
+        }
+        else if (cp == 0x490) {
+            cp = 0x491;  // Ґ → ґ
+        }
+        if (cp == 0x451 || cp == 0x450) {
+            cp = 0x435;  // ё, ѐ → е
+        }
+        AppendUtf8(out, cp);
+    }
+    return out;
+}
+
+std::vector<std::string> SearchIndex::Tokenize(std::string_view text) {
+    const std::string folded = Fold(text);
+
+    std::vector<std::string> words;
+    std::string word;
+    std::size_t pos = 0;
+    while (pos < folded.size()) {
+        const std::size_t start = pos;
+        const char32_t cp = DecodeUtf8(folded, pos);
+        if (IsSeparator(cp)) {
+            if (!word.empty()) {
+                words.push_back(std::move(word));
+                word.clear();
+            }
+            continue;
+        }
+        word.append(folded, start, pos - start);
+    }
+    if (!word.empty()) {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+void SearchIndex::Add(int id, std::string_view text) {
+    const auto doc = static_cast<std::uint32_t>(docIds.size());
+    auto words = Tokenize(text);
+    constexpr std::size_t kMaxWords = std::numeric_limits<std::uint16_t>::max();
+    const auto length = static_cast<std::uint16_t>(std::min(words.size(), kMaxWords));
+
+    docIds.push_back(id);
+    docLengths.push_back(length);
+    for (std::uint16_t position = 0; position < length; ++position) {
+        pending.push_back(PendingPosting{std::move(words[position]), Posting{doc, position}});
+    }
+}
+
+void SearchIndex::Build() {
+    std::ranges::sort(pending, [](const auto& a, const auto& b) {
+        return std::tie(a.word, a.posting.doc, a.posting.position) <
+               std::tie(b.word, b.posting.doc, b.posting.position);
+    });
+
+    terms.clear();
+    postings.clear();
+    postings.reserve(pending.size());
+    for (auto& entry : pending) {
+        if (terms.empty() || terms.back().word != entry.word) {
+            const auto first = static_cast<std::uint32_t>(postings.size());
+            terms.push_back(Term{std::move(entry.word), first, first});
+        }
+        postings.push_back(entry.posting);
+        terms.back().lastPosting = static_cast<std::uint32_t>(postings.size());
+    }
+
+    pending.clear();
+    pending.shrink_to_fit();
+    terms.shrink_to_fit();
+}
+
+void SearchIndex::Clear() {
+    docIds.clear();
+    docLengths.clear();
+    terms.clear();
+    postings.clear();
+    pending.clear();
+}
+
+std::vector<int> SearchIndex::Search(std::string_view query, std::size_t limit) const {
+    auto words = Tokenize(query);
+    if (words.empty() || limit == 0) {
+        return {};
+    }
+    words.resize(std::min(words.size(), kMaxQueryWords));
+
+    // Dense per-document scores: short prefixes match a large share of the catalog,
+    // and a flat array beats hashing every posting. Only touched entries are reset afterwards,
+    // so the per-thread buffers stay zeroed between calls.
+    auto& [scores, wordScores, touched, candidates] = tlsScratch;
+    if (scores.size() < docIds.size()) {
+        scores.resize(docIds.size(), 0);
+        wordScores.resize(docIds.size(), 0);
+    }
+    candidates.clear();
+
+    for (std::size_t w = 0; w < words.size(); ++w) {
+        const std::string& word = words[w];
+
+        auto term = std::ranges::lower_bound(terms, word, {}, &Term::word);
+        for (; term != terms.end() && term->word.starts_with(word); ++term) {
+            const int matchScore = term->word.size() == word.size() ? kExactWordScore : kPrefixWordScore;
+            for (auto p = term->firstPosting; p < term->lastPosting; ++p) {
+                const Posting& posting = postings[p];
+                const int leadingScore = posting.position == 0 ? kLeadingWordScore : 0;
+                const auto score = static_cast<std::uint8_t>(matchScore + leadingScore);
+                auto& wordScore = wordScores[posting.doc];
+                if (wordScore == 0) {
+                    touched.push_back(posting.doc);
+                }
+                wordScore = std::max(wordScore, score);
+            }
+        }
+
+        // A document stays a candidate only while every query word matches it
+        if (w == 0) {
+            candidates = touched;
+        }
+        else {
+            std::erase_if(candidates, [&](const std::uint32_t doc) {
+                if (wordScores[doc] == 0) {
+                    scores[doc] = 0;
+                    return true;
+                }
+                return false;
+            });
+        }
+        for (const auto doc : candidates) {
+            scores[doc] += wordScores[doc];
+        }
+        for (const auto doc : touched) {
+            wordScores[doc] = 0;
+        }
+        touched.clear();
+
+        if (candidates.empty()) {
+            return {};
+        }
+    }
+
+    const auto better = [this, &scores](const std::uint32_t a, const std::uint32_t b) {
+        if (scores[a] != scores[b]) {
+            return scores[a] > scores[b];
+        }
+        if (docLengths[a] != docLengths[b]) {
+            return docLengths[a] < docLengths[b];
+        }
+        return a < b;
+    };
+    const auto count = std::min(limit, candidates.size());
+    std::partial_sort(
+        candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(count), candidates.end(), better);
+
+    std::vector<int> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(docIds[candidates[i]]);
+    }
+    for (const auto doc : candidates) {
+        scores[doc] = 0;
+    }
+    return result;
+}
+
+}  // namespace booking_service
@@ -0,0 +1,81 @@
+#include "SeatStore.h"
+
+#include <bit>
+
+namespace booking_service {
+
+namespace detail {
+
+void CollectFreeSeats(std::uint64_t bookedWord,
+                      std::size_t wordIndex,
+                      std::uint32_t capacity,
+                      std::size_t count,
+                      std::vector<std::uint32_t>& out) {
+    for (std::uint64_t freeBits = ~bookedWord; freeBits != 0 && out.size() < count; freeBits &= freeBits - 1) {
+        const auto seat = static_cast<std::uint32_t>(wordIndex * kSeatsPerWord + std::countr_zero(freeBits));
+        if (seat >= capacity) {
+            return;
+        }
+        out.push_back(seat);
+    }
+}
+
+}  // namespace detail
+
+HierarchicalSeatStore::HierarchicalSeatStore(std::uint32_t capacity)
+    : wordCount(static_cast<std::uint32_t>(SeatWordCount(capacity)))
+    , capacity(capacity) {
+    bits.assign(wordCount + SeatWordCount(wordCount), 0);
+    Assign(std::vector<std::uint64_t>(wordCount, 0));
+}
+
+void HierarchicalSeatStore::FindFree(std::size_t count, std::vector<std::uint32_t>& out) const {
+    for (std::size_t s = wordCount; s < bits.size() && out.size() < count; ++s) {
+        // Summary bits past the last seat word read as open; the search stops there
+        for (std::uint64_t open = ~bits[s]; open != 0 && out.size() < count; open &= open - 1) {
+            const std::size_t w = (s - wordCount) * kSeatsPerWord + std::countr_zero(open);
+            if (w >= wordCount) {
+                break;
+            }
+            detail::CollectFreeSeats(bits[w], w, capacity, count, out);
+        }
+    }
+}
+
+std::vector<std::uint64_t> HierarchicalSeatStore::Bitmap() const {
+    std::vector<std::uint64_t> bitmap(bits.begin(), bits.begin() + wordCount);
+    if (!bitmap.empty()) {
+        bitmap.back() &= ~detail::PaddingBits(capacity);
+    }
+    return bitmap;
+}
+
+bool HierarchicalSeatStore::Assign(const std::vector<std::uint64_t>& bitmap) {
+    const auto padding = detail::PaddingBits(capacity);
+    if (bitmap.size() != wordCount || (wordCount > 0 && (bitmap.back() & padding))) {
+        return false;
+    }
+    std::ranges::copy(bitmap, bits.begin());
+    std::fill(bits.begin() + wordCount, bits.end(), 0);
+    if (wordCount > 0) {
+        bits[wordCount - 1] |= padding;
+    }
+    for (std::size_t w = 0; w < wordCount; ++w) {
+        if (bits[w] == ~std::uint64_t{0}) {
+            bits[wordCount + w / kSeatsPerWord] |= std::uint64_t{1} << (w % kSeatsPerWord);
+        }
+    }
+    return true;
+}
+
+SeatState MakeSeatState(std::uint32_t capacity) {
+    if (capacity <= FixedSeatStore<1>::kMaxSeats) {
+        return FixedSeatStore<1>(capacity);
+    }
+    if (capacity <= FixedSeatStore<4>::kMaxSeats) {
+        return FixedSeatStore<4>(capacity);
+    }
+    return HierarchicalSeatStore(capacity);
+}
+
+}  // namespace booking_service
@@ -0,0 +1,168 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace booking_service {
+
+namespace {
+
+constexpr std::string_view kTraceHeader = "# booking trace v2";
+constexpr std::string_view kBookOp = "book";
+constexpr std::string_view kSeatsOp = "seats";
+constexpr std::string_view kNone = "-";
+constexpr std::string_view kHexDigits = "0123456789ABCDEF";
+
+/**
+ * Percent-encodes the characters that delimit fields or seat ids, plus '%' itself.
+ */
+std::string EncodeSeatId(std::string_view seatId) {
+    std::string encoded;
+    encoded.reserve(seatId.size());
+    for (const char c : seatId) {
+        const auto byte = static_cast<unsigned char>(c);
+        if (byte <= ' ' || byte == 0x7F || c == ',' || c == '-' || c == '%') {
+            encoded += '%';
+            encoded += kHexDigits[byte >> 4];
+            encoded += kHexDigits[byte & 0xF];
+        }
+        else {
+            encoded += c;
+        }
+    }
+    return encoded;
+}
+
+std::optional<std::string> DecodeSeatId(std::string_view encoded) {
+    std::string seatId;
+    seatId.reserve(encoded.size());
+    for (std::size_t i = 0; i < encoded.size(); ++i) {
+        if (encoded[i] != '%') {
+            seatId += encoded[i];
+            continue;
+        }
+        if (i + 2 >= encoded.size()) {
+            return std::nullopt;
+        }
+        const auto high = kHexDigits.find(encoded[i + 1]);
+        const auto low = kHexDigits.find(encoded[i + 2]);
+        if (high == std::string_view::npos || low == std::string_view::npos) {
+            return std::nullopt;
+        }
+        seatId += static_cast<char>(high << 4 | low);
+        i += 2;
+    }
+    return seatId;
+}
+
+}  // namespace
+
+TraceRecorder::TraceRecorder()
+    : start(std::chrono::steady_clock::now()) {
+}
+
+std::int64_t TraceRecorder::Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void TraceRecorder::Record(TraceEvent event) {
+    std::lock_guard lock(mtx);
+    events.push_back(std::move(event));
+}
+
+std::vector<TraceEvent> TraceRecorder::Events() const {
+    std::vector<TraceEvent> result;
+    {
+        std::lock_guard lock(mtx);
+        result = events;
+    }
+    std::ranges::stable_sort(result, {}, &TraceEvent::startNs);
+    return result;
+}
+
+void SaveTrace(const fs::path& file, const std::vector<TraceEvent>& events) {
+    std::ofstream out(file, std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open trace for writing: " + file.string());
+    }
+
+    out << kTraceHeader << '\n';
+    for (const auto& event : events) {
+        out << event.startNs << ' ' << event.durationNs << ' '
+            << (event.op == TraceOp::BookSeats ? kBookOp : kSeatsOp) << ' ' << event.screeningId << ' '
+            << event.theaterId << ' ' << event.movieId << ' ';
+        if (event.success) {
+            out << (*event.success ? '1' : '0');
+        }
+        else {
+            out << kNone;
+        }
+        out << ' ';
+        if (event.seatIds.empty()) {
+            out << kNone;
+        }
+        for (std::size_t i = 0; i < event.seatIds.size(); ++i) {
+            if (event.seatIds[i].empty()) {
+                throw std::runtime_error("Empty seat id cannot be saved in a trace: " + file.string());
+            }
+            out << (i > 0 ? "," : "") << EncodeSeatId(event.seatIds[i]);
+        }
+        out << '\n';
+    }
+
+    if (!out) {
+        throw std::runtime_error("Failed to write trace: " + file.string());
+    }
+}
+
+std::vector<TraceEvent> LoadTrace(const fs::path& file) {
+    std::ifstream in(file);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open trace: " + file.string());
+    }
+
+    std::vector<TraceEvent> events;
+    std::string line;
+    std::size_t lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        TraceEvent event;
+        std::string op;
+        std::string success;
+        std::string seats;
+        if (!(fields >> event.startNs >> event.durationNs >> op >> event.screeningId >> event.theaterId >>
+              event.movieId >> success >> seats) ||
+            (op != kBookOp && op != kSeatsOp) || (success != "1" && success != "0" && success != kNone)) {
+            throw std::runtime_error("Malformed trace line " + std::to_string(lineNo) + " in " + file.string());
+        }
+
+        event.op = op == kBookOp ? TraceOp::BookSeats : TraceOp::GetSeats;
+        if (success != kNone) {
+            event.success = success == "1";
+        }
+        if (seats != kNone) {
+            std::istringstream seatList(seats);
+            std::string encoded;
+            while (std::getline(seatList, encoded, ',')) {
+                auto seatId = DecodeSeatId(encoded);
+                if (!seatId || seatId->empty()) {
+                    throw std::runtime_error("Malformed seat id on trace line " + std::to_string(lineNo) + " in " +
+                                             file.string());
+                }
+                event.seatIds.push_back(std::move(*seatId));
+            }
+        }
+        events.push_back(std::move(event));
+    }
+    return events;
+}
+
+}  // namespace booking_service
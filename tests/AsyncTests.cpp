@@ -0,0 +1,382 @@
+#include "Async.h"
+#include "BookingService.h"
+#include "DataStore.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace booking_service;
+
+namespace {
+
+Task<int> Answer() {
+    co_return 42;
+}
+
+Task<int> Fail() {
+    throw std::runtime_error("failed");
+    co_return 0;
+}
+
+Task<void> Book(BookingService& service,
+                int theaterId,
+                int movieId,
+                std::vector<std::string> seatIds,
+                Executor& executor,
+                std::optional<BookingResult>& result) {
+    result = co_await service.BookSeatsAsync(theaterId, movieId, seatIds, executor);
+}
+
+Task<void> ReadSeats(BookingService& service,
+                     int theaterId,
+                     int movieId,
+                     Executor& executor,
+                     std::vector<Seat>& seats) {
+    seats = co_await service.GetSeatsAsync(theaterId, movieId, executor);
+}
+
+/**
+ * @brief Executor that drops everything posted to it, so nothing it is handed is ever resumed.
+ */
+class DiscardingExecutor : public Executor {
+public:
+    void Post(std::function<void()>) override {}
+};
+
+/**
+ * @brief Executor whose worker threads run posted work as soon as they pick it up.
+ */
+class ThreadPoolExecutor : public Executor {
+public:
+    explicit ThreadPoolExecutor(int threads) {
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([this]() { Work(); });
+        }
+    }
+
+    ~ThreadPoolExecutor() override {
+        stop = true;
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void Post(std::function<void()> work) override {
+        std::lock_guard lock(mtx);
+        pending.push_back(std::move(work));
+    }
+
+private:
+    void Work() {
+        for (;;) {
+            std::function<void()> work;
+            {
+                std::lock_guard lock(mtx);
+                if (!pending.empty()) {
+                    work = std::move(pending.front());
+                    pending.pop_front();
+                }
+                else if (stop) {
+                    return;
+                }
+            }
+            if (work) {
+                work();
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    std::mutex mtx;
+    std::deque<std::function<void()>> pending;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> workers;
+};
+
+Task<void> BookAndCount(BookingService& service,
+                        std::string seatId,
+                        Executor& executor,
+                        std::atomic<int>& booked,
+                        std::atomic<int>& done) {
+    const std::vector<std::string> seatIds{std::move(seatId)};
+    const auto result = co_await service.BookSeatsAsync(1, 1, seatIds, executor);
+    booked += result.status == BookingStatus::Booked;
+    ++done;
+}
+
+Task<void> ReadAndCount(BookingService& service, Executor& executor, std::atomic<int>& done) {
+    co_await service.GetSeatsAsync(1, 1, executor);
+    ++done;
+}
+
+}  // namespace
+
+class AsyncBookingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        store = std::make_shared<DataStore>();
+        store->LoadData("data");
+        service = std::make_unique<BookingService>(store);
+    }
+
+    std::shared_ptr<DataStore> store;
+    std::unique_ptr<BookingService> service;
+    LoopExecutor executor;
+};
+
+TEST(TaskTest, ReturnsValuesAndPropagatesExceptions) {
+    int value = 0;
+    bool caught = false;
+    Spawn([](int& value, bool& caught) -> Task<void> {
+        value = co_await Answer();
+        try {
+            co_await Fail();
+        }
+        catch (const std::runtime_error&) {
+            caught = true;
+        }
+    }(value, caught));
+
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(caught);
+}
+
+TEST_F(AsyncBookingTest, UncontendedCallsCompleteWithoutSuspending) {
+    std::optional<BookingResult> result;
+    Spawn(Book(*service, 1, 1, {"a1", "a2"}, executor, result));
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->status, BookingStatus::Booked);
+    EXPECT_EQ(result->totalPrice, 2 * 12000);
+
+    std::vector<Seat> seats;
+    Spawn(ReadSeats(*service, 1, 1, executor, seats));
+    ASSERT_EQ(seats.size(), 20);
+    EXPECT_TRUE(seats[0].isBooked);
+    EXPECT_FALSE(seats[2].isBooked);
+    EXPECT_EQ(executor.RunPending(), 0);
+}
+
+TEST_F(AsyncBookingTest, InvalidRequestsFailLikeBlockingCalls) {
+    std::optional<BookingResult> result;
+    Spawn(Book(*service, 1, 1, {"a1"}, executor, result));
+    Spawn(Book(*service, 1, 1, {"a1"}, executor, result));
+    EXPECT_EQ(result->status, BookingStatus::Rejected);
+    Spawn(Book(*service, 1, 1, {"z99"}, executor, result));
+    EXPECT_EQ(result->status, BookingStatus::Rejected);
+    Spawn(Book(*service, 9999, 1, {"a1"}, executor, result));
+    EXPECT_EQ(result->status, BookingStatus::Rejected);
+
+    std::vector<Seat> seats{Seat{}};
+    Spawn(ReadSeats(*service, 9999, 1, executor, seats));
+    EXPECT_TRUE(seats.empty());
+}
+
+// Coroutines on one event loop race blocking threads for the same seats; every seat ends up
+// booked exactly once and every coroutine is resumed
+TEST_F(AsyncBookingTest, AsyncAndBlockingBookingsShareTheShowQueue) {
+    store->SetAdmissionPolicy({true, 1000});
+    constexpr int kSeats = 20;
+    constexpr int kRounds = 10;
+
+    std::atomic<int> blockingBooked{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < kSeats * kRounds; ++i) {
+                const std::string seatId = "a" + std::to_string((i + t) % kSeats + 1);
+                blockingBooked += static_cast<bool>(service->BookSeats(1, 1, {seatId}));
+            }
+        });
+    }
+
+    std::vector<std::optional<BookingResult>> results(kSeats * kRounds);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        Spawn(Book(*service, 1, 1, {"a" + std::to_string(i % kSeats + 1)}, executor, results[i]));
+    }
+    const auto allDone = [&results]() {
+        return std::ranges::all_of(results, [](const auto& result) { return result.has_value(); });
+    };
+    while (!allDone()) {
+        executor.RunPending();
+        std::this_thread::yield();
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    int asyncBooked = 0;
+    for (const auto& result : results) {
+        asyncBooked += result->status == BookingStatus::Booked;
+        EXPECT_NE(result->status, BookingStatus::Overloaded);
+    }
+    EXPECT_EQ(asyncBooked + blockingBooked, kSeats);
+}
+
+// Coroutine requests queued behind blocking threads are applied by those threads; the event loop
+// only resumes them, so neither the show nor a blocking call made on the loop thread waits for it
+TEST_F(AsyncBookingTest, ShowProgressDoesNotDependOnTheExecutor) {
+    store->SetAdmissionPolicy({true, 1000});
+    constexpr int kAsyncSeats = 10;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 200; ++i) {
+                service->BookSeats(1, 1, {"a" + std::to_string(12 + (i + t) % 9)});
+            }
+        });
+    }
+    std::vector<std::optional<BookingResult>> results(kAsyncSeats);
+    for (int i = 0; i < kAsyncSeats; ++i) {
+        Spawn(Book(*service, 1, 1, {"a" + std::to_string(i + 1)}, executor, results[i]));
+    }
+    EXPECT_EQ(service->BookSeats(1, 1, {"a11"}).status, BookingStatus::Booked);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (const auto& seat : service->GetSeats(1, 1)) {
+        EXPECT_TRUE(seat.isBooked) << seat.id;
+    }
+    executor.RunPending();
+    for (const auto& result : results) {
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->status, BookingStatus::Booked);
+    }
+}
+
+TEST_F(AsyncBookingTest, DestroyedCoroutinesWithdrawTheirRequests) {
+    store->SetAdmissionPolicy({true, 2});
+    DiscardingExecutor discarding;
+
+    std::atomic<bool> stop{false};
+    std::thread contender([&]() {
+        while (!stop.load()) {
+            service->BookSeats(1, 1, {"a1"});
+        }
+    });
+    for (int i = 0; i < 2000; ++i) {
+        // Started by hand so the test owns the frame; if the booking had to queue, destroying the
+        // task below withdraws it while the coroutine is still suspended
+        std::optional<BookingResult> result;
+        auto task = Book(*service, 1, 1, {"a2"}, discarding, result);
+        task.await_suspend(std::noop_coroutine()).resume();
+    }
+    stop = true;
+    contender.join();
+
+    // Withdrawn bookings no longer count against maxQueuedBookings
+    EXPECT_EQ(service->BookSeats(1, 1, {"a3"}).status, BookingStatus::Booked);
+}
+
+// The coroutine runs to completion and frees its frame on a pool thread, possibly while the thread
+// that applied its request is still finishing the batch
+TEST_F(AsyncBookingTest, CoroutinesResumeOnAThreadPool) {
+    store->SetAdmissionPolicy({true, 1000});
+    constexpr int kRequests = 2000;
+    constexpr int kSeats = 20;
+
+    std::atomic<int> asyncBooked{0};
+    std::atomic<int> done{0};
+    std::atomic<int> blockingBooked{0};
+    {
+        ThreadPoolExecutor pool(3);
+        std::thread contender([&]() {
+            for (int i = 0; done.load() < kRequests; ++i) {
+                blockingBooked += static_cast<bool>(service->BookSeats(1, 1, {"a" + std::to_string(i % kSeats + 1)}));
+                service->GetSeats(1, 1);
+            }
+        });
+        for (int i = 0; i < kRequests; ++i) {
+            const std::string seatId = "a" + std::to_string(i % kSeats + 1);
+            if (i % 2 == 0) {
+                Spawn(BookAndCount(*service, seatId, pool, asyncBooked, done));
+            }
+            else {
+                Spawn(ReadAndCount(*service, pool, done));
+            }
+        }
+        contender.join();
+    }
+    EXPECT_EQ(done.load(), kRequests);
+    EXPECT_EQ(asyncBooked + blockingBooked, kSeats);
+}
+
+// Event loops sharing a hot show each apply at most one batch inline and never wait for the show
+// lock, whether bookings are combined or not; a loop that stops draining its executor does not
+// hold up the others
+TEST(AsyncLoopsTest, LoopsSharingAShowStayResponsive) {
+    constexpr int kLoops = 3;
+    constexpr int kRequestsPerLoop = 3000;
+    constexpr auto kPromptly = std::chrono::milliseconds{100};
+
+    for (const bool combine : {true, false}) {
+        auto store = std::make_shared<DataStore>();
+        store->LoadData("data");
+        store->SetAdmissionPolicy({combine, 1000});
+        BookingService service(store);
+        std::atomic<bool> stop{false};
+        std::thread crowd([&]() {
+            for (int i = 0; !stop.load(); ++i) {
+                service.BookSeats(1, 1, {"a" + std::to_string(i % 20 + 1)});
+                service.GetSeats(1, 1);
+            }
+        });
+
+        LoopExecutor stopped;
+        std::atomic<int> stoppedDone{0};
+        for (int i = 0; i < 10; ++i) {
+            Spawn(ReadAndCount(service, stopped, stoppedDone));
+        }
+
+        std::vector<std::chrono::steady_clock::duration> slowest(kLoops);
+        std::vector<std::thread> loops;
+        for (int l = 0; l < kLoops; ++l) {
+            loops.emplace_back([&, l]() {
+                LoopExecutor loopExecutor;
+                std::atomic<int> done{0};
+                std::atomic<int> booked{0};
+                for (int e = 0; e < kRequestsPerLoop; ++e) {
+                    const auto start = std::chrono::steady_clock::now();
+                    if (e % 4 == 0) {
+                        Spawn(BookAndCount(service, "a" + std::to_string(e % 20 + 1), loopExecutor, booked, done));
+                    }
+                    else {
+                        Spawn(ReadAndCount(service, loopExecutor, done));
+                    }
+                    slowest[l] = std::max(slowest[l], std::chrono::steady_clock::now() - start);
+                    loopExecutor.RunPending();
+                }
+                while (done.load() < kRequestsPerLoop) {
+                    loopExecutor.RunPending();
+                    std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& loop : loops) {
+            loop.join();
+        }
+        stop = true;
+        crowd.join();
+
+        for (int l = 0; l < kLoops; ++l) {
+            EXPECT_LT(slowest[l], kPromptly) << "loop " << l << (combine ? " combining" : " show lock");
+        }
+        while (stoppedDone.load() < 10) {
+            stopped.RunPending();
+        }
+    }
+}
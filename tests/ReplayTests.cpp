@@ -0,0 +1,148 @@
+#include "BookingService.h"
+#include "DataStore.h"
+#include "Replayer.h"
+#include "Trace.h"
+#include "TraceGenerator.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace booking_service;
+using namespace booking_service::replay;
+
+namespace {
+
+TraceEvent Booking(std::int64_t startNs, int screeningId, std::vector<std::string> seatIds) {
+    return TraceEvent{.startNs = startNs, .op = TraceOp::BookSeats, .screeningId = screeningId, .seatIds = seatIds};
+}
+
+}  // namespace
+
+class ReplayTest : public ::testing::Test {
+protected:
+    void SetUp() override { store.LoadData("data"); }
+
+    ReplayReport ReplayOnFreshStore(const std::vector<TraceEvent>& events, const ReplayOptions& options) {
+        DataStore target;
+        target.LoadData("data");
+        return Replay(target, events, options);
+    }
+
+    DataStore store;
+};
+
+TEST_F(ReplayTest, GeneratedTraceReplaysAndVerifies) {
+    GeneratorOptions generator;
+    generator.events = 4000;
+    generator.ratePerSecond = 1e6;
+    generator.zipfExponent = 1.2;
+    generator.bursts = 2;
+    generator.burstSize = 500;
+    generator.seed = 7;
+    const auto events = GenerateTrace(store, generator);
+    ASSERT_EQ(events.size(), 5000);
+    EXPECT_TRUE(std::ranges::is_sorted(events, {}, &TraceEvent::startNs));
+
+    const auto serial = ReplayOnFreshStore(events, {.threads = 1});
+    EXPECT_TRUE(serial.Verified());
+    EXPECT_EQ(serial.unknownTargets, 0);
+    EXPECT_GT(serial.bookingsSucceeded, 0);
+    EXPECT_GT(serial.bookingsFailed, 0);
+    EXPECT_EQ(serial.bookLatency.count + serial.readLatency.count, events.size());
+    EXPECT_EQ(serial.bookLatency.count, serial.bookingsSucceeded + serial.bookingsFailed);
+
+    // Events of a show stay on one thread in trace order, so outcomes do not depend on the thread count
+    const auto parallel = ReplayOnFreshStore(events, {.threads = 4});
+    EXPECT_TRUE(parallel.Verified());
+    EXPECT_EQ(parallel.bookingsSucceeded, serial.bookingsSucceeded);
+    EXPECT_EQ(parallel.bookingsFailed, serial.bookingsFailed);
+}
+
+TEST_F(ReplayTest, SpreadReplayVerifiesSuccessfulBookings) {
+    GeneratorOptions generator;
+    generator.events = 3000;
+    generator.ratePerSecond = 1e6;
+    generator.zipfExponent = 1.5;
+    generator.bursts = 2;
+    generator.burstSize = 1000;
+    generator.seed = 11;
+    const auto events = GenerateTrace(store, generator);
+
+    const auto report = ReplayOnFreshStore(events, {.threads = 4, .spreadShows = true});
+    EXPECT_TRUE(report.Verified());
+    EXPECT_EQ(report.bookLatency.count, report.bookingsSucceeded + report.bookingsFailed);
+    EXPECT_GT(report.bookingsSucceeded, 0);
+
+    // Recorded outcomes depend on the original timing, so a spread replay does not check them
+    auto first = Booking(0, 0, {"a1"});
+    first.success = false;
+    const auto spread = ReplayOnFreshStore({first}, {.threads = 2, .spreadShows = true});
+    EXPECT_TRUE(spread.Verified());
+    EXPECT_EQ(spread.outcomeMismatches, 0);
+}
+
+TEST_F(ReplayTest, RecordedSessionReplaysWithMatchingOutcomes) {
+    auto shared = std::make_shared<DataStore>();
+    shared->LoadData("data");
+    BookingService service(shared);
+    auto recorder = std::make_shared<TraceRecorder>();
+    service.SetTraceRecorder(recorder);
+    ASSERT_TRUE(service.BookSeats(1, 1, {"a1", "a2"}));
+    ASSERT_FALSE(service.BookSeats(1, 1, {"a2", "a3"}));
+    ASSERT_TRUE(service.BookSeats(2, 3, {"a3"}));
+    service.GetSeats(1, 1);
+    ASSERT_TRUE(service.BookSeats(1, 1, {"a3"}));
+
+    const auto report = ReplayOnFreshStore(recorder->Events(), {.threads = 3});
+    EXPECT_TRUE(report.Verified());
+    EXPECT_EQ(report.outcomeMismatches, 0);
+    EXPECT_EQ(report.bookingsSucceeded, 3);
+    EXPECT_EQ(report.bookingsFailed, 1);
+}
+
+TEST_F(ReplayTest, VerificationFailsWhenRecordedOutcomesDiffer) {
+    auto first = Booking(0, 0, {"a1"});
+    first.success = false;
+    auto second = Booking(1, 0, {"a2"});
+    second.success = true;
+
+    const auto report = ReplayOnFreshStore({first, second}, {});
+    EXPECT_FALSE(report.Verified());
+    EXPECT_EQ(report.outcomeMismatches, 1);
+    ASSERT_EQ(report.violations.size(), 1);
+    EXPECT_NE(report.violations[0].find("recorded final state"), std::string::npos);
+}
+
+TEST_F(ReplayTest, UnknownShowsAreSkipped) {
+    const auto report =
+        ReplayOnFreshStore({Booking(0, 9999, {"a1"}), Booking(1, 0, {"a1"}), Booking(2, 0, {"a1"})}, {.threads = 2});
+    EXPECT_TRUE(report.Verified());
+    EXPECT_EQ(report.unknownTargets, 1);
+    EXPECT_EQ(report.bookingsSucceeded, 1);
+    EXPECT_EQ(report.bookingsFailed, 1);
+}
+
+TEST_F(ReplayTest, OriginalPaceWaitsForRecordedStartTimes) {
+    const std::vector<TraceEvent> events{
+        Booking(0, 0, {"a1"}), Booking(20'000'000, 1, {"a1"}), Booking(40'000'000, 0, {"a2"})};
+    const auto report = ReplayOnFreshStore(events, {.threads = 2, .originalPace = true});
+    EXPECT_TRUE(report.Verified());
+    EXPECT_GE(report.elapsedSeconds, 0.04);
+}
+
+TEST_F(ReplayTest, GeneratorRejectsInvalidOptions) {
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    constexpr double kInfinity = std::numeric_limits<double>::infinity();
+    for (const double rate : {0.0, -5.0, kNaN, kInfinity}) {
+        EXPECT_THROW(GenerateTrace(store, {.ratePerSecond = rate}), std::invalid_argument) << rate;
+    }
+    EXPECT_THROW(GenerateTrace(store, {.zipfExponent = -1}), std::invalid_argument);
+    EXPECT_THROW(GenerateTrace(store, {.readRatio = 1.5}), std::invalid_argument);
+    EXPECT_THROW(GenerateTrace(store, {.burstWindow = std::chrono::milliseconds{-1}}), std::invalid_argument);
+    EXPECT_EQ(GenerateTrace(store, {.events = 10, .readRatio = 1}).size(), 10);
+}
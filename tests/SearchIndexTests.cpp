@@ -0,0 +1,53 @@
+#include "SearchIndex.h"
+
+#include <gtest/gtest.h>
+
+using namespace booking_service;
+
+class SearchIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        index.Add(1, "The Matrix");
+        index.Add(2, "The Matrix Reloaded");
+        index.Add(3, "Amélie");
+        index.Add(4, "Zhovten Cinema");
+        index.Add(5, "Кінотеатр Жовтень");
+        index.Add(6, "Matrimony");
+        index.Build();
+    }
+
+    SearchIndex index;
+};
+
+TEST_F(SearchIndexTest, FoldsCaseAndDiacritics) {
+    EXPECT_EQ(SearchIndex::Fold("AMÉLIE Straße Œuvre"), "amelie strasse oeuvre");
+    EXPECT_EQ(SearchIndex::Fold("Жовтень"), "жовтень");
+}
+
+TEST_F(SearchIndexTest, MatchesWordPrefixes) {
+    EXPECT_EQ(index.Search("zhov", 10), std::vector<int>{4});
+    EXPECT_EQ(index.Search("CINE", 10), std::vector<int>{4});
+    EXPECT_EQ(index.Search("amel", 10), std::vector<int>{3});
+    EXPECT_EQ(index.Search("AMÉLIE", 10), std::vector<int>{3});
+    EXPECT_EQ(index.Search("жовт", 10), std::vector<int>{5});
+    EXPECT_EQ(index.Search("ЖОВТЕНЬ", 10), std::vector<int>{5});
+}
+
+TEST_F(SearchIndexTest, RanksExactAndShorterMatchesFirst) {
+    // "matrix" is an exact word in 1 and 2 and only a prefix match in none; 1 is shorter
+    EXPECT_EQ(index.Search("matrix", 10), (std::vector<int>{1, 2}));
+    // "matri" prefix-matches 1, 2 and 6; 6 starts with it
+    EXPECT_EQ(index.Search("matri", 10), (std::vector<int>{6, 1, 2}));
+}
+
+TEST_F(SearchIndexTest, RequiresEveryQueryWord) {
+    EXPECT_EQ(index.Search("matrix rel", 10), std::vector<int>{2});
+    EXPECT_TRUE(index.Search("matrix cinema", 10).empty());
+}
+
+TEST_F(SearchIndexTest, RespectsLimitAndEmptyQueries) {
+    EXPECT_EQ(index.Search("the", 1).size(), 1);
+    EXPECT_TRUE(index.Search("", 10).empty());
+    EXPECT_TRUE(index.Search("  --  ", 10).empty());
+    EXPECT_TRUE(index.Search("nothing", 10).empty());
+}
@@ -0,0 +1,90 @@
+#include "SeatStore.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace booking_service;
+
+namespace {
+
+std::vector<std::uint32_t> FindFree(const SeatState& state, std::size_t count) {
+    std::vector<std::uint32_t> out;
+    std::visit([&](const auto& store) { store.FindFree(count, out); }, state);
+    return out;
+}
+
+void Book(SeatState& state, std::uint32_t first, std::uint32_t last) {
+    std::visit(
+        [&](auto& store) {
+            for (auto seat = first; seat < last; ++seat) {
+                store.Book(seat);
+            }
+        },
+        state);
+}
+
+}  // namespace
+
+TEST(SeatStoreTest, PicksBackendByCapacity) {
+    EXPECT_TRUE(std::holds_alternative<FixedSeatStore<1>>(MakeSeatState(20)));
+    EXPECT_TRUE(std::holds_alternative<FixedSeatStore<1>>(MakeSeatState(64)));
+    EXPECT_TRUE(std::holds_alternative<FixedSeatStore<4>>(MakeSeatState(65)));
+    EXPECT_TRUE(std::holds_alternative<FixedSeatStore<4>>(MakeSeatState(256)));
+    EXPECT_TRUE(std::holds_alternative<HierarchicalSeatStore>(MakeSeatState(257)));
+    EXPECT_TRUE(std::holds_alternative<HierarchicalSeatStore>(MakeSeatState(60000)));
+}
+
+TEST(SeatStoreTest, FindFreeStopsAtCapacity) {
+    for (const std::uint32_t capacity : {20u, 200u, 1000u}) {
+        SeatState state = MakeSeatState(capacity);
+        Book(state, 0, capacity - 3);
+
+        EXPECT_EQ(FindFree(state, 10), (std::vector<std::uint32_t>{capacity - 3, capacity - 2, capacity - 1}));
+        EXPECT_EQ(FindFree(state, 2), (std::vector<std::uint32_t>{capacity - 3, capacity - 2}));
+
+        Book(state, capacity - 3, capacity);
+        EXPECT_TRUE(FindFree(state, 10).empty());
+    }
+}
+
+TEST(SeatStoreTest, HierarchicalSkipsFullBlocks) {
+    constexpr std::uint32_t kCapacity = 60000;
+    SeatState state = MakeSeatState(kCapacity);
+    Book(state, 0, 50000);
+    Book(state, 50001, 59990);
+
+    std::vector<std::uint32_t> expected{50000};
+    for (std::uint32_t seat = 59990; seat < 59995; ++seat) {
+        expected.push_back(seat);
+    }
+    EXPECT_EQ(FindFree(state, 6), expected);
+}
+
+TEST(SeatStoreTest, AssignRebuildsSummaries) {
+    constexpr std::uint32_t kCapacity = 5000;
+    SeatState state = MakeSeatState(kCapacity);
+    Book(state, 0, 4999);
+    const auto bitmap = std::visit([](const auto& store) { return store.Bitmap(); }, state);
+    ASSERT_EQ(bitmap.size(), SeatWordCount(kCapacity));
+    EXPECT_EQ(bitmap.back() >> (kCapacity % kSeatsPerWord), 0u);
+
+    SeatState copy = MakeSeatState(kCapacity);
+    EXPECT_TRUE(std::visit([&](auto& store) { return store.Assign(bitmap); }, copy));
+    EXPECT_EQ(FindFree(copy, 5), std::vector<std::uint32_t>{4999});
+    EXPECT_FALSE(std::visit([](auto& store) { return store.Assign({1, 2}); }, copy));
+}
+
+TEST(SeatStoreTest, SeatsPastCapacityStayUnbooked) {
+    for (const std::uint32_t capacity : {20u, 200u, 1000u}) {
+        SeatState state = MakeSeatState(capacity);
+        Book(state, capacity, capacity + 100);
+        EXPECT_TRUE(std::visit([&](const auto& store) { return store.IsBooked(capacity); }, state));
+        EXPECT_EQ(FindFree(state, 1), std::vector<std::uint32_t>{0});
+
+        auto bitmap = std::visit([](const auto& store) { return store.Bitmap(); }, state);
+        EXPECT_EQ(std::count(bitmap.begin(), bitmap.end(), 0u), bitmap.size()) << capacity;
+        bitmap.back() |= std::uint64_t{1} << (capacity % kSeatsPerWord);
+        EXPECT_FALSE(std::visit([&](auto& store) { return store.Assign(bitmap); }, state)) << capacity;
+    }
+}
@@ -3,11 +3,24 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <future>
 #include <thread>
 #include <vector>
 
 using namespace booking_service;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::chrono::sys_seconds At(int hour, int minute = 0) {
+    return std::chrono::sys_days{std::chrono::year{2026} / 10 / 18} + std::chrono::hours{hour} +
+           std::chrono::minutes{minute};
+}
+
+}  // namespace
 
 class BookingServiceTest : public ::testing::Test {
 protected:
@@ -42,7 +55,7 @@ TEST_F(BookingServiceTest, GetSeatsReturnsSeats) {
 
 TEST_F(BookingServiceTest, BookSeatsSuccess) {
     std::vector<std::string> seatsToBook = {"a1", "a2"};
-    bool success = service->BookSeats(1, 1, seatsToBook);
+    auto success = service->BookSeats(1, 1, seatsToBook);
     EXPECT_TRUE(success);
 
     auto seats = service->GetSeats(1, 1);
@@ -53,6 +66,427 @@ TEST_F(BookingServiceTest, BookSeatsSuccess) {
     }
 }
 
+TEST_F(BookingServiceTest, BookSeatsReturnsTotalPrice) {
+    auto result = service->BookSeats(1, 1, {"a1", "a2"});
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.totalPrice, 2 * 12000);
+}
+
+TEST_F(BookingServiceTest, BookSeatsPricesBySeatClass) {
+    // Theater 3: a1..a20 are standard, a21..a30 are vip
+    auto result = service->BookSeats(3, 2, {"a1", "a21"});
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.totalPrice, 18000 + 30000);
+
+    auto seats = service->GetSeats(3, 2);
+    ASSERT_EQ(seats.size(), 30);
+    EXPECT_EQ(seats[0].seatClass, 0);
+    EXPECT_EQ(seats[29].seatClass, 1);
+}
+
+TEST_F(BookingServiceTest, BookSeatsUsesShowPriceOverride) {
+    auto result = service->BookSeats(3, 4, {"a1", "a21"});
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.totalPrice, 18000 + 35000);
+}
+
+TEST(ShowPriceTest, NegativeOverridesAreSkipped) {
+    const auto dir = std::filesystem::temp_directory_path() / "booking_price_test";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "movies.json") << R"([{"id": 1, "title": "Movie"}])";
+    std::ofstream(dir / "theaters.json") << R"([{"id": 1, "name": "Hall", "capacity": 2, "seatClasses": [
+        {"name": "standard", "seats": 1, "price": 1000},
+        {"name": "vip", "seats": 1, "price": 3000}
+    ]}])";
+    std::ofstream(dir / "mappings.json") << R"({"1": [{"theaterId": 1, "prices": {"standard": -500, "vip": 2500}}]})";
+
+    DataStore dataStore;
+    dataStore.LoadData(dir);
+    std::filesystem::remove_all(dir);
+
+    const auto result = dataStore.BookSeats(1, 1, {"a1", "a2"});
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.totalPrice, 1000 + 2500);
+}
+
+TEST_F(BookingServiceTest, FailedBookingHasNoPrice) {
+    auto result = service->BookSeats(1, 1, {"z99"});
+    EXPECT_FALSE(result);
+    EXPECT_EQ(result.totalPrice, 0);
+}
+
+TEST_F(BookingServiceTest, PricingPolicyUsesOccupancy) {
+    std::vector<int> observedOccupancy;
+    store->SetPricingPolicy([&](std::int64_t basePrice, const PricingContext& context) {
+        observedOccupancy.push_back(context.bookedSeats);
+        EXPECT_EQ(context.capacity, 20);
+        // Surge by 50% once half of the show is sold
+        return context.bookedSeats * 2 >= context.capacity ? basePrice * 3 / 2 : basePrice;
+    });
+
+    std::vector<std::string> firstHalf;
+    for (int i = 1; i <= 10; ++i) {
+        firstHalf.push_back("a" + std::to_string(i));
+    }
+    auto first = service->BookSeats(1, 1, firstHalf);
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first.totalPrice, 10 * 12000);
+
+    auto second = service->BookSeats(1, 1, {"a11"});
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second.totalPrice, 18000);
+    EXPECT_EQ(observedOccupancy.back(), 10);
+}
+
+TEST_F(BookingServiceTest, SearchMoviesByPrefix) {
+    EXPECT_EQ(service->SearchMovies("inter", 10), std::vector<int>{3});
+    EXPECT_EQ(service->SearchMovies("THE MAT", 10), std::vector<int>{1});
+    EXPECT_TRUE(service->SearchMovies("avatar", 10).empty());
+}
+
+TEST_F(BookingServiceTest, SearchTheatersByPrefix) {
+    EXPECT_EQ(service->SearchTheaters("zhovten", 10), std::vector<int>{1});
+    EXPECT_EQ(service->SearchTheaters("cinema", 10), (std::vector<int>{1, 3}));
+}
+
+TEST_F(BookingServiceTest, GetScreeningsInTimeRange) {
+    auto screenings = service->GetScreenings(1, At(17), At(17) + 3h);
+    ASSERT_EQ(screenings.size(), 2);
+    EXPECT_EQ(screenings[0].theaterId, 1);
+    EXPECT_EQ(screenings[0].startTime, At(18));
+    EXPECT_EQ(screenings[1].theaterId, 2);
+    EXPECT_EQ(screenings[1].startTime, At(19));
+
+    EXPECT_EQ(service->GetScreenings(1, At(0), At(23, 59)).size(), 3);
+    EXPECT_TRUE(service->GetScreenings(1, At(22), At(23)).empty());
+    EXPECT_TRUE(service->GetScreenings(9999, At(0), At(23)).empty());
+}
+
+TEST_F(BookingServiceTest, GetTheaterScreeningsInTimeRange) {
+    // The range is half-open: a screening starting at `to` is excluded
+    auto screenings = service->GetTheaterScreenings(1, At(18), At(21, 30));
+    ASSERT_EQ(screenings.size(), 1);
+    EXPECT_EQ(screenings[0].movieId, 1);
+    EXPECT_EQ(screenings[0].startTime, At(18));
+}
+
+TEST_F(BookingServiceTest, ScreeningsHaveIndependentSeats) {
+    auto screenings = service->GetTheaterScreenings(1, At(0), At(23, 59));
+    ASSERT_EQ(screenings.size(), 2);
+
+    EXPECT_TRUE(service->BookSeats(screenings[1].id, {"a1"}));
+    EXPECT_FALSE(service->BookSeats(screenings[1].id, {"a1"}));
+    EXPECT_TRUE(service->GetSeats(screenings[1].id)[0].isBooked);
+    EXPECT_FALSE(service->GetSeats(screenings[0].id)[0].isBooked);
+
+    // The (theater, movie) overloads address the earliest screening
+    EXPECT_TRUE(service->BookSeats(1, 1, {"a1"}));
+    EXPECT_TRUE(service->GetSeats(screenings[0].id)[0].isBooked);
+}
+
+TEST_F(BookingServiceTest, UnscheduledMappingHasSingleScreening) {
+    // Movie 2 is mapped to theaters 1 and 3 without showtimes
+    auto screening = store->GetScreening(1, 2);
+    ASSERT_TRUE(screening.has_value());
+    EXPECT_EQ(screening->movieId, 2);
+    EXPECT_EQ(screening->theaterId, 1);
+    EXPECT_FALSE(screening->startTime.has_value());
+    EXPECT_EQ(store->GetScreening(screening->id)->id, screening->id);
+
+    // Unscheduled screenings stay out of time-range queries, including around the epoch
+    const auto epoch = std::chrono::sys_seconds{};
+    EXPECT_TRUE(service->GetScreenings(2, epoch - 24h, epoch + 24h).empty());
+    EXPECT_TRUE(service->GetScreenings(2, std::chrono::sys_seconds::min(), std::chrono::sys_seconds::max()).empty());
+    EXPECT_EQ(service->GetTheaterScreenings(1, std::chrono::sys_seconds::min(), std::chrono::sys_seconds::max()).size(),
+              2);
+
+    EXPECT_TRUE(service->BookSeats(1, 2, {"a1"}));
+    EXPECT_TRUE(service->GetSeats(screening->id)[0].isBooked);
+    EXPECT_FALSE(store->GetScreening(2, 2).has_value());
+}
+
+TEST(ShowtimeParsingTest, RequiresWholeStringAndAppliesOffsets) {
+    const auto dir = std::filesystem::temp_directory_path() / "booking_showtime_test";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "movies.json") << R"([{"id": 1, "title": "Movie"}])";
+    std::ofstream(dir / "theaters.json") << R"([{"id": 1, "name": "Hall", "capacity": 4}])";
+    std::ofstream(dir / "mappings.json") << R"({"1": [{"theaterId": 1, "showtimes": [
+        "2026-10-18T10:00",
+        "2026-10-18T11:00:30Z",
+        "2026-10-18T14:00+02:00",
+        "2026-10-18T08:15:00-05:00",
+        1791028800,
+        "2026-10-18T19:00junk",
+        "2026-10-18T19:00Zjunk",
+        "2026-10-18T19:00+2",
+        "2026-10-18T19:00+02:00:00",
+        "2026-10-18T19:0",
+        "2026-10-18 19:00",
+        "2026-02-30T19:00",
+        "2026-10-18T24:00"
+    ]}]})";
+
+    DataStore dataStore;
+    dataStore.LoadData(dir);
+    std::filesystem::remove_all(dir);
+
+    std::vector<std::chrono::sys_seconds> times;
+    for (const auto& screening : dataStore.GetScreenings(1, At(0), At(23, 59))) {
+        times.push_back(*screening.startTime);
+    }
+    EXPECT_EQ(times, (std::vector<std::chrono::sys_seconds>{At(10), At(11) + 30s, At(12), At(13, 15)}));
+    EXPECT_EQ(dataStore.GetScreenings(1, std::chrono::sys_seconds::min(), std::chrono::sys_seconds::max()).size(), 5);
+}
+
+TEST_F(BookingServiceTest, BookSeatsInvalidScreening) {
+    EXPECT_FALSE(service->BookSeats(9999, {"a1"}));
+    EXPECT_FALSE(service->BookSeats(-1, {"a1"}));
+    EXPECT_TRUE(service->GetSeats(9999).empty());
+    EXPECT_FALSE(store->GetScreening(9999).has_value());
+}
+
+TEST_F(BookingServiceTest, SnapshotRoundTripRestoresState) {
+    ASSERT_TRUE(service->BookSeats(1, 1, {"a1", "a2"}));
+    ASSERT_TRUE(service->BookSeats(3, 4, {"a21"}));
+    auto screenings = service->GetTheaterScreenings(1, At(0), At(23, 59));
+    ASSERT_EQ(screenings.size(), 2);
+    ASSERT_TRUE(service->BookSeats(screenings[1].id, {"a7"}));
+
+    const auto snapshot = std::filesystem::temp_directory_path() / "booking_service_test.snapshot";
+    store->ExportSnapshot(snapshot);
+
+    auto replica = std::make_shared<DataStore>();
+    replica->ImportSnapshot(snapshot);
+    std::filesystem::remove(snapshot);
+    BookingService replicaService(replica);
+
+    EXPECT_EQ(replicaService.GetMovies().size(), service->GetMovies().size());
+    EXPECT_EQ(replicaService.GetTheaters(4).size(), 3);
+    for (int id = 0; store->GetScreening(id).has_value(); ++id) {
+        auto original = store->GetScreening(id);
+        auto restored = replica->GetScreening(id);
+        ASSERT_TRUE(restored.has_value());
+        EXPECT_EQ(restored->movieId, original->movieId);
+        EXPECT_EQ(restored->theaterId, original->theaterId);
+        EXPECT_EQ(restored->startTime, original->startTime);
+        EXPECT_EQ(replica->GetVersion(id), store->GetVersion(id));
+
+        auto originalSeats = store->GetSeats(id);
+        auto restoredSeats = replica->GetSeats(id);
+        ASSERT_EQ(restoredSeats.size(), originalSeats.size());
+        for (std::size_t i = 0; i < originalSeats.size(); ++i) {
+            EXPECT_EQ(restoredSeats[i].id, originalSeats[i].id);
+            EXPECT_EQ(restoredSeats[i].isBooked, originalSeats[i].isBooked);
+            EXPECT_EQ(restoredSeats[i].seatClass, originalSeats[i].seatClass);
+        }
+    }
+
+    // Indexes and prices are rebuilt, and the replica keeps accepting bookings
+    EXPECT_EQ(replicaService.SearchTheaters("zhov", 10), std::vector<int>{1});
+    EXPECT_EQ(replicaService.GetScreenings(1, At(17), At(20)).size(), 2);
+    EXPECT_FALSE(replicaService.BookSeats(1, 1, {"a1"}));
+    auto result = replicaService.BookSeats(3, 4, {"a22"});
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.totalPrice, 35000);
+}
+
+TEST_F(BookingServiceTest, ImportSnapshotRejectsCorruptedFile) {
+    const auto snapshot = std::filesystem::temp_directory_path() / "booking_service_corrupted.snapshot";
+    store->ExportSnapshot(snapshot);
+    std::filesystem::resize_file(snapshot, std::filesystem::file_size(snapshot) / 2);
+
+    DataStore replica;
+    EXPECT_THROW(replica.ImportSnapshot(snapshot), std::runtime_error);
+
+    std::ofstream(snapshot, std::ios::trunc) << "not a snapshot";
+    EXPECT_THROW(replica.ImportSnapshot(snapshot), std::runtime_error);
+    std::filesystem::remove(snapshot);
+
+    EXPECT_THROW(replica.ImportSnapshot(snapshot), std::runtime_error);
+}
+
+TEST_F(BookingServiceTest, FailedImportKeepsStoreUnchanged) {
+    ASSERT_TRUE(service->BookSeats(1, 1, {"a1"}));
+    const auto snapshot = std::filesystem::temp_directory_path() / "booking_service_partial.snapshot";
+    store->ExportSnapshot(snapshot);
+    std::filesystem::resize_file(snapshot, std::filesystem::file_size(snapshot) - 16);
+
+    EXPECT_THROW(store->ImportSnapshot(snapshot), std::runtime_error);
+    std::filesystem::remove(snapshot);
+
+    EXPECT_EQ(service->GetMovies().size(), 4);
+    EXPECT_EQ(service->SearchTheaters("zhov", 10), std::vector<int>{1});
+    EXPECT_EQ(service->GetScreenings(1, At(17), At(20)).size(), 2);
+    EXPECT_TRUE(service->GetSeats(1, 1)[0].isBooked);
+    EXPECT_FALSE(service->BookSeats(1, 1, {"a1"}));
+    EXPECT_TRUE(service->BookSeats(1, 1, {"a2"}));
+}
+
+TEST_F(BookingServiceTest, ImportSnapshotChecksBookedSeatCount) {
+    int lastId = 0;
+    while (store->GetScreening(lastId + 1).has_value()) {
+        ++lastId;
+    }
+    ASSERT_TRUE(service->BookSeats(lastId, {"a1"}));
+    const auto snapshot = std::filesystem::temp_directory_path() / "booking_service_count.snapshot";
+    store->ExportSnapshot(snapshot);
+
+    // The last show ends with its booked seat count, the bitmap word count and words, then the trailer
+    const auto seats = store->GetSeats(lastId).size();
+    const auto words = (seats + 63) / 64;
+    const auto countOffset = std::filesystem::file_size(snapshot) - 8 - words * 8 - 4 - 4;
+    {
+        std::fstream file(snapshot, std::ios::binary | std::ios::in | std::ios::out);
+        const int bogusCount = 2;
+        file.seekp(static_cast<std::streamoff>(countOffset));
+        file.write(reinterpret_cast<const char*>(&bogusCount), sizeof(bogusCount));
+    }
+
+    DataStore replica;
+    EXPECT_THROW(replica.ImportSnapshot(snapshot), std::runtime_error);
+    std::filesystem::remove(snapshot);
+}
+
+TEST_F(BookingServiceTest, TraceRecorderCapturesCallsAndRoundTrips) {
+    auto recorder = std::make_shared<TraceRecorder>();
+    service->SetTraceRecorder(recorder);
+    ASSERT_TRUE(service->BookSeats(1, 1, {"a1", "a2"}));
+    ASSERT_FALSE(service->BookSeats(1, 1, {"a2"}));
+    service->GetSeats(0);
+    service->SetTraceRecorder(nullptr);
+    service->BookSeats(1, 1, {"a3"});
+
+    const auto events = recorder->Events();
+    ASSERT_EQ(events.size(), 3);
+    EXPECT_EQ(events[0].op, TraceOp::BookSeats);
+    EXPECT_EQ(events[0].theaterId, 1);
+    EXPECT_EQ(events[0].movieId, 1);
+    EXPECT_EQ(events[0].screeningId, -1);
+    EXPECT_EQ(events[0].success, true);
+    EXPECT_EQ(events[0].seatIds, (std::vector<std::string>{"a1", "a2"}));
+    EXPECT_EQ(events[1].success, false);
+    EXPECT_EQ(events[2].op, TraceOp::GetSeats);
+    EXPECT_EQ(events[2].screeningId, 0);
+    EXPECT_FALSE(events[2].success.has_value());
+    EXPECT_LE(events[0].startNs, events[1].startNs);
+
+    const auto file = std::filesystem::temp_directory_path() / "booking_service_test.trace";
+    SaveTrace(file, events);
+    const auto loaded = LoadTrace(file);
+    std::filesystem::remove(file);
+    ASSERT_EQ(loaded.size(), events.size());
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(loaded[i].startNs, events[i].startNs);
+        EXPECT_EQ(loaded[i].durationNs, events[i].durationNs);
+        EXPECT_EQ(loaded[i].op, events[i].op);
+        EXPECT_EQ(loaded[i].screeningId, events[i].screeningId);
+        EXPECT_EQ(loaded[i].theaterId, events[i].theaterId);
+        EXPECT_EQ(loaded[i].movieId, events[i].movieId);
+        EXPECT_EQ(loaded[i].success, events[i].success);
+        EXPECT_EQ(loaded[i].seatIds, events[i].seatIds);
+    }
+}
+
+TEST_F(BookingServiceTest, LoadTraceRejectsMalformedLine) {
+    const auto file = std::filesystem::temp_directory_path() / "booking_service_malformed.trace";
+    std::ofstream(file, std::ios::trunc) << "# booking trace v1\n10 0 cancel 1 -1 -1 - a1\n";
+    EXPECT_THROW(LoadTrace(file), std::runtime_error);
+    std::filesystem::remove(file);
+}
+
+TEST_F(BookingServiceTest, TraceEscapesSeatIds) {
+    const std::vector<std::string> seatIds{"a,1", "b 2", "-", "50%", "x-y", "tab\there", "Київ"};
+    const auto file = std::filesystem::temp_directory_path() / "booking_service_escaped.trace";
+    SaveTrace(file, {TraceEvent{.op = TraceOp::BookSeats, .screeningId = 0, .seatIds = seatIds}});
+    const auto loaded = LoadTrace(file);
+    ASSERT_EQ(loaded.size(), 1);
+    EXPECT_EQ(loaded[0].seatIds, seatIds);
+
+    EXPECT_THROW(SaveTrace(file, {TraceEvent{.op = TraceOp::BookSeats, .seatIds = {"a1", ""}}}), std::runtime_error);
+    std::ofstream(file, std::ios::trunc) << "10 0 book 1 -1 -1 - a1,%2\n";
+    EXPECT_THROW(LoadTrace(file), std::runtime_error);
+    std::filesystem::remove(file);
+}
+
+TEST_F(BookingServiceTest, VersionCountsSuccessfulBookings) {
+    const auto screening = store->GetScreening(1, 2);
+    ASSERT_TRUE(screening.has_value());
+    const int id = screening->id;
+    EXPECT_EQ(store->GetVersion(id), 0u);
+    EXPECT_TRUE(service->BookSeats(id, {"a1"}));
+    EXPECT_FALSE(service->BookSeats(id, {"a1"}));
+    EXPECT_TRUE(service->BookSeats(id, {"a2", "a3"}));
+    EXPECT_EQ(store->GetVersion(id), 2u);
+    EXPECT_FALSE(store->GetVersion(9999).has_value());
+}
+
+TEST_F(BookingServiceTest, SoldOutShowRejectsWithStatus) {
+    // Theater 2 has 20 seats: a1..a20
+    std::vector<std::string> allButOne;
+    for (int i = 1; i < 20; ++i) {
+        allButOne.push_back("a" + std::to_string(i));
+    }
+    ASSERT_TRUE(service->BookSeats(2, 1, allButOne));
+    EXPECT_EQ(service->BookSeats(2, 1, {"a1"}).status, BookingStatus::Rejected);
+    EXPECT_EQ(service->BookSeats(2, 1, {"a20", "a19"}).status, BookingStatus::Rejected);
+    EXPECT_EQ(service->BookSeats(2, 1, {"a20"}).status, BookingStatus::Booked);
+
+    const auto screeningId = service->GetScreenings(1, At(19), At(19) + 1s).at(0).id;
+    const auto version = store->GetVersion(screeningId);
+    auto result = service->BookSeats(2, 1, {"a1"});
+    EXPECT_EQ(result.status, BookingStatus::SoldOut);
+    EXPECT_EQ(result.totalPrice, 0);
+    EXPECT_EQ(store->GetVersion(screeningId), version);
+}
+
+TEST_F(BookingServiceTest, FindFreeSeatsSkipsBookedSeats) {
+    const auto screeningId = service->GetScreenings(1, At(19), At(19) + 1s).at(0).id;
+    ASSERT_TRUE(service->BookSeats(screeningId, {"a1", "a2", "a4"}));
+    EXPECT_EQ(service->FindFreeSeats(screeningId, 3), (std::vector<std::string>{"a3", "a5", "a6"}));
+    EXPECT_EQ(service->FindFreeSeats(screeningId, 100).size(), 17);
+    EXPECT_TRUE(service->FindFreeSeats(9999, 3).empty());
+}
+
+// Bounded queue: every request gets a definite answer and no seat is booked twice
+TEST_F(BookingServiceTest, AdmissionPolicyBoundsQueuedBookings) {
+    for (const bool combine : {true, false}) {
+        // A fresh store per policy, so the second round starts from free seats
+        auto limitedStore = std::make_shared<DataStore>();
+        limitedStore->LoadData("data");
+        limitedStore->SetAdmissionPolicy({combine, 2});
+        BookingService limitedService(limitedStore);
+
+        std::atomic<int> booked{0};
+        std::atomic<int> overloaded{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 64; ++i) {
+            threads.emplace_back([&, i]() {
+                const auto result = limitedService.BookSeats(1, 1, {"a" + std::to_string(i % 20 + 1)});
+                booked += result.status == BookingStatus::Booked;
+                overloaded += result.status == BookingStatus::Overloaded;
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        int bookedSeats = 0;
+        for (const auto& seat : limitedService.GetSeats(1, 1)) {
+            bookedSeats += seat.isBooked;
+        }
+        EXPECT_EQ(bookedSeats, booked);
+        EXPECT_GT(booked, 0);
+        if (!combine) {
+            EXPECT_EQ(overloaded, 0);
+        }
+    }
+}
+
+TEST_F(BookingServiceTest, AdmissionPolicyRejectsEmptyQueue) {
+    EXPECT_THROW(store->SetAdmissionPolicy({true, 0}), std::invalid_argument);
+    EXPECT_TRUE(service->BookSeats(1, 1, {"a1"}));
+}
+
 TEST_F(BookingServiceTest, BookSeatsFailureAlreadyBooked) {
     std::vector<std::string> seatsToBook = {"a1"};
     EXPECT_TRUE(service->BookSeats(1, 1, seatsToBook));
@@ -81,7 +515,7 @@ TEST_F(BookingServiceTest, GetSeatsInvalidMovie) {
 
 TEST_F(BookingServiceTest, BookSeatsEmptyList) {
     std::vector<std::string> seatsToBook = {};
-    bool success = service->BookSeats(1, 1, seatsToBook);
+    auto success = service->BookSeats(1, 1, seatsToBook);
     EXPECT_FALSE(success);
 }
 
@@ -118,7 +552,7 @@ TEST_F(BookingServiceTest, CompleteBookingFlow) {
     ASSERT_FALSE(seats.empty());
 
     std::vector<std::string> seatsToBook = {seats[0].id};
-    bool success = service->BookSeats(theaters[0].id, movies[0].id, seatsToBook);
+    auto success = service->BookSeats(theaters[0].id, movies[0].id, seatsToBook);
     EXPECT_TRUE(success);
 
     auto updatedSeats = service->GetSeats(theaters[0].id, movies[0].id);
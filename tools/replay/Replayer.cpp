@@ -0,0 +1,208 @@
+#include "Replayer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <set>
+#include <thread>
+
+namespace booking_service::replay {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Outcome {
+    std::int64_t latencyNs = 0;
+    bool success = false;
+};
+
+/**
+ * Resolves (theaterId, movieId) targets to the screening DataStore books for the pair.
+ */
+int ResolveScreening(const DataStore& store, const TraceEvent& event, std::map<std::pair<int, int>, int>& cache) {
+    if (event.screeningId >= 0) {
+        return store.GetScreening(event.screeningId) ? event.screeningId : -1;
+    }
+
+    auto [it, inserted] = cache.try_emplace({event.theaterId, event.movieId}, -1);
+    if (inserted) {
+        if (const auto screening = store.GetScreening(event.theaterId, event.movieId)) {
+            it->second = screening->id;
+        }
+    }
+    return it->second;
+}
+
+LatencySummary Summarize(std::vector<std::int64_t> samples) {
+    LatencySummary summary;
+    summary.count = samples.size();
+    if (samples.empty()) {
+        return summary;
+    }
+    std::ranges::sort(samples);
+    const auto at = [&samples](double p) {
+        return samples[static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1))];
+    };
+    summary.p50Ns = at(0.5);
+    summary.p99Ns = at(0.99);
+    summary.p999Ns = at(0.999);
+    summary.maxNs = samples.back();
+    return summary;
+}
+
+std::set<std::string> BookedSeats(const DataStore& store, int screeningId) {
+    std::set<std::string> booked;
+    for (const auto& seat : store.GetSeats(screeningId)) {
+        if (seat.isBooked) {
+            booked.insert(seat.id);
+        }
+    }
+    return booked;
+}
+
+/**
+ * Adds the seats of successful bookings to `booked`; returns false if a seat would be granted twice.
+ */
+bool ApplyBooking(std::set<std::string>& booked, const std::vector<std::string>& seatIds) {
+    bool unique = true;
+    for (const auto& seatId : std::set<std::string>(seatIds.begin(), seatIds.end())) {
+        unique &= booked.insert(seatId).second;
+    }
+    return unique;
+}
+
+}  // namespace
+
+ReplayReport Replay(DataStore& store, const std::vector<TraceEvent>& events, const ReplayOptions& options) {
+    ReplayReport report;
+    report.events = events.size();
+    const auto threads = static_cast<std::size_t>(std::max(1, options.threads));
+
+    // Route each show to one thread so that its events keep their trace order, or deal its events
+    // over all threads so that they contend the way concurrent clients do
+    std::map<std::pair<int, int>, int> pairCache;
+    std::vector<int> targets(events.size());
+    std::vector<std::vector<std::size_t>> queues(threads);
+    std::map<int, std::set<std::string>> initialState;
+    std::map<int, std::size_t> dealt;
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        targets[i] = ResolveScreening(store, events[i], pairCache);
+        if (targets[i] < 0) {
+            ++report.unknownTargets;
+            continue;
+        }
+        if (!initialState.contains(targets[i])) {
+            initialState.emplace(targets[i], BookedSeats(store, targets[i]));
+        }
+        const auto target = static_cast<std::size_t>(targets[i]);
+        queues[(options.spreadShows ? target + dealt[targets[i]]++ : target) % threads].push_back(i);
+    }
+
+    std::vector<Outcome> outcomes(events.size());
+    std::vector<std::thread> workers;
+    const auto start = Clock::now();
+    for (const auto& queue : queues) {
+        workers.emplace_back([&, start]() {
+            for (const auto i : queue) {
+                const TraceEvent& event = events[i];
+                if (options.originalPace) {
+                    std::this_thread::sleep_until(start + std::chrono::nanoseconds{event.startNs});
+                }
+                const auto callStart = Clock::now();
+                if (event.op == TraceOp::BookSeats) {
+                    outcomes[i].success = static_cast<bool>(store.BookSeats(targets[i], event.seatIds));
+                }
+                else {
+                    store.GetSeats(targets[i]);
+                }
+                outcomes[i].latencyNs =
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - callStart).count();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    report.elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Expected state per show: initial seats plus the bookings that succeeded (replayed and recorded)
+    std::vector<std::int64_t> bookSamples;
+    std::vector<std::int64_t> readSamples;
+    std::map<int, std::set<std::string>> replayed = initialState;
+    std::map<int, std::set<std::string>> recorded = initialState;
+    bool hasRecordedOutcomes = false;
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        if (targets[i] < 0) {
+            continue;
+        }
+        const TraceEvent& event = events[i];
+        if (event.op != TraceOp::BookSeats) {
+            readSamples.push_back(outcomes[i].latencyNs);
+            continue;
+        }
+
+        bookSamples.push_back(outcomes[i].latencyNs);
+        if (outcomes[i].success) {
+            ++report.bookingsSucceeded;
+            if (!ApplyBooking(replayed[targets[i]], event.seatIds)) {
+                report.violations.push_back("seat granted twice in screening " + std::to_string(targets[i]));
+            }
+        }
+        else {
+            ++report.bookingsFailed;
+        }
+
+        if (event.success && !options.spreadShows) {
+            hasRecordedOutcomes = true;
+            report.outcomeMismatches += *event.success != outcomes[i].success;
+            if (*event.success) {
+                ApplyBooking(recorded[targets[i]], event.seatIds);
+            }
+        }
+    }
+    report.bookLatency = Summarize(std::move(bookSamples));
+    report.readLatency = Summarize(std::move(readSamples));
+
+    for (const auto& [screeningId, expected] : replayed) {
+        const auto actual = BookedSeats(store, screeningId);
+        if (actual != expected) {
+            report.violations.push_back("screening " + std::to_string(screeningId) +
+                                        " does not match the successful bookings of the replay");
+        }
+        if (hasRecordedOutcomes && actual != recorded[screeningId]) {
+            report.violations.push_back("screening " + std::to_string(screeningId) +
+                                        " does not match the recorded final state");
+        }
+    }
+    return report;
+}
+
+void PrintReport(std::ostream& out, const ReplayReport& report) {
+    const auto printLatency = [&out](const char* label, const LatencySummary& latency) {
+        out << label << ": n=" << latency.count << " p50=" << latency.p50Ns / 1000.0
+            << "us p99=" << latency.p99Ns / 1000.0 << "us p999=" << latency.p999Ns / 1000.0
+            << "us max=" << latency.maxNs / 1000.0 << "us\n";
+    };
+
+    out << "events: " << report.events << " in " << report.elapsedSeconds << "s ("
+        << static_cast<double>(report.events) / std::max(report.elapsedSeconds, 1e-9) << " ops/s)\n";
+    out << "bookings: " << report.bookingsSucceeded << " succeeded, " << report.bookingsFailed << " failed\n";
+    if (report.unknownTargets > 0) {
+        out << "skipped events for unknown shows: " << report.unknownTargets << "\n";
+    }
+    out << "outcome mismatches vs recording: " << report.outcomeMismatches << "\n";
+    printLatency("book latency", report.bookLatency);
+    printLatency("read latency", report.readLatency);
+
+    if (report.Verified()) {
+        out << "verification: OK\n";
+        return;
+    }
+    out << "verification: FAILED (" << report.violations.size() << " problems)\n";
+    for (const auto& violation : report.violations) {
+        out << "  " << violation << "\n";
+    }
+}
+
+}  // namespace booking_service::replay
@@ -0,0 +1,57 @@
+#pragma once
+#include "DataStore.h"
+#include "Trace.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace booking_service::replay {
+
+struct ReplayOptions {
+    int threads = 1;
+    bool originalPace = false;  ///< Sleep until each event's recorded start time instead of running flat out.
+    /// Deal each show's events round-robin over all threads, so requests for one show run concurrently
+    /// as they did in production. Outcomes then depend on timing, so they are not checked against the
+    /// recording; the final state is still checked against the bookings that succeeded.
+    bool spreadShows = false;
+};
+
+struct LatencySummary {
+    std::size_t count = 0;
+    std::int64_t p50Ns = 0;
+    std::int64_t p99Ns = 0;
+    std::int64_t p999Ns = 0;
+    std::int64_t maxNs = 0;
+};
+
+struct ReplayReport {
+    std::size_t events = 0;
+    double elapsedSeconds = 0;
+    std::size_t bookingsSucceeded = 0;
+    std::size_t bookingsFailed = 0;
+    std::size_t unknownTargets = 0;     ///< Events whose show does not exist in the store.
+    std::size_t outcomeMismatches = 0;  ///< Bookings whose outcome differs from the recorded one (per-show order).
+    LatencySummary bookLatency;
+    LatencySummary readLatency;
+    std::vector<std::string> violations;  ///< Final seat state problems; empty when verification passed.
+
+    bool Verified() const { return violations.empty(); }
+};
+
+/**
+ * @brief Replays a trace against a store and verifies the resulting seat state.
+ *
+ * By default events of one show always run on the same thread in trace order, so the per-show
+ * order of the trace is kept while different shows run in parallel and outcomes are deterministic;
+ * ReplayOptions::spreadShows replays each show's events concurrently instead. Afterwards every
+ * touched show must hold exactly its initial seats plus the seats of the bookings that succeeded
+ * during the replay, with no seat granted twice. In per-show order, when the trace carries recorded
+ * outcomes, the final state must also equal the one implied by the recording.
+ */
+ReplayReport Replay(DataStore& store, const std::vector<TraceEvent>& events, const ReplayOptions& options);
+
+void PrintReport(std::ostream& out, const ReplayReport& report);
+
+}  // namespace booking_service::replay
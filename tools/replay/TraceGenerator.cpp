@@ -0,0 +1,151 @@
+#include "TraceGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace booking_service::replay {
+
+namespace {
+
+/**
+ * Samples screening ids with Zipfian popularity. Popularity ranks are shuffled so that
+ * hot screenings are spread over the catalog.
+ */
+class ZipfianPicker {
+public:
+    ZipfianPicker(int screenings, double exponent, std::mt19937_64& rng)
+        : ranked(static_cast<std::size_t>(screenings)) {
+        std::iota(ranked.begin(), ranked.end(), 0);
+        std::ranges::shuffle(ranked, rng);
+
+        cdf.reserve(ranked.size());
+        double sum = 0;
+        for (std::size_t rank = 1; rank <= ranked.size(); ++rank) {
+            sum += 1.0 / std::pow(static_cast<double>(rank), exponent);
+            cdf.push_back(sum);
+        }
+        for (auto& value : cdf) {
+            value /= sum;
+        }
+    }
+
+    int Pick(std::mt19937_64& rng) const {
+        const double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        const auto rank = std::min(static_cast<std::size_t>(std::ranges::lower_bound(cdf, u) - cdf.begin()),
+                                   ranked.size() - 1);
+        return ranked[rank];
+    }
+
+    int MostPopular(std::size_t rank) const { return ranked[std::min(rank, ranked.size() - 1)]; }
+
+private:
+    std::vector<int> ranked;
+    std::vector<double> cdf;
+};
+
+class EventFactory {
+public:
+    EventFactory(const DataStore& store, int maxSeats)
+        : store(store)
+        , maxSeats(maxSeats) {
+    }
+
+    TraceEvent Booking(int screeningId, std::int64_t startNs, std::mt19937_64& rng) {
+        const auto& seatIds = SeatIds(screeningId);
+        const int count = std::uniform_int_distribution<int>(1, std::min<int>(maxSeats, seatIds.size()))(rng);
+        const auto first =
+            std::uniform_int_distribution<std::size_t>(0, seatIds.size() - static_cast<std::size_t>(count))(rng);
+
+        TraceEvent event{.startNs = startNs, .op = TraceOp::BookSeats, .screeningId = screeningId};
+        event.seatIds.assign(seatIds.begin() + static_cast<std::ptrdiff_t>(first),
+                             seatIds.begin() + static_cast<std::ptrdiff_t>(first) + count);
+        return event;
+    }
+
+    TraceEvent Read(int screeningId, std::int64_t startNs) const {
+        return TraceEvent{.startNs = startNs, .op = TraceOp::GetSeats, .screeningId = screeningId};
+    }
+
+private:
+    const std::vector<std::string>& SeatIds(int screeningId) {
+        auto [it, inserted] = seatIdCache.try_emplace(screeningId);
+        if (inserted) {
+            for (const auto& seat : store.GetSeats(screeningId)) {
+                it->second.push_back(seat.id);
+            }
+        }
+        return it->second;
+    }
+
+    const DataStore& store;
+    const int maxSeats;
+    std::unordered_map<int, std::vector<std::string>> seatIdCache;
+};
+
+void ValidateOptions(const GeneratorOptions& options) {
+    // The distributions below have undefined behavior outside these ranges; NaN fails every check
+    if (!(options.ratePerSecond > 0) || !std::isfinite(options.ratePerSecond)) {
+        throw std::invalid_argument("Arrival rate must be a positive number");
+    }
+    if (!(options.zipfExponent >= 0) || !std::isfinite(options.zipfExponent)) {
+        throw std::invalid_argument("Zipf exponent must be a non-negative number");
+    }
+    if (!(options.readRatio >= 0 && options.readRatio <= 1)) {
+        throw std::invalid_argument("Read ratio must be between 0 and 1");
+    }
+    if (options.burstWindow.count() < 0) {
+        throw std::invalid_argument("Burst window must not be negative");
+    }
+}
+
+}  // namespace
+
+std::vector<TraceEvent> GenerateTrace(const DataStore& store, const GeneratorOptions& options) {
+    ValidateOptions(options);
+
+    int screenings = 0;
+    while (store.GetScreening(screenings)) {
+        ++screenings;
+    }
+    if (screenings == 0) {
+        throw std::runtime_error("Store has no screenings to generate a trace for");
+    }
+
+    std::mt19937_64 rng(options.seed);
+    const ZipfianPicker picker(screenings, options.zipfExponent, rng);
+    EventFactory factory(store, std::max(1, options.maxSeatsPerBooking));
+
+    std::vector<TraceEvent> events;
+    events.reserve(options.events + static_cast<std::size_t>(options.bursts) * options.burstSize);
+
+    std::exponential_distribution<double> gapSeconds(options.ratePerSecond);
+    std::bernoulli_distribution isRead(options.readRatio);
+    double now = 0;
+    for (std::size_t i = 0; i < options.events; ++i) {
+        now += gapSeconds(rng);
+        const auto startNs = static_cast<std::int64_t>(now * 1e9);
+        const int screeningId = picker.Pick(rng);
+        events.push_back(isRead(rng) ? factory.Read(screeningId, startNs) : factory.Booking(screeningId, startNs, rng));
+    }
+
+    // Each burst hammers one of the most popular screenings at a random moment of the trace
+    const auto durationNs = std::max<std::int64_t>(1, static_cast<std::int64_t>(now * 1e9));
+    const auto windowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(options.burstWindow).count();
+    for (int burst = 0; burst < options.bursts; ++burst) {
+        const int screeningId = picker.MostPopular(static_cast<std::size_t>(burst));
+        const auto burstStart = std::uniform_int_distribution<std::int64_t>(0, durationNs)(rng);
+        std::uniform_int_distribution<std::int64_t> offset(0, std::max<std::int64_t>(0, windowNs));
+        for (std::size_t i = 0; i < options.burstSize; ++i) {
+            events.push_back(factory.Booking(screeningId, burstStart + offset(rng), rng));
+        }
+    }
+
+    std::ranges::stable_sort(events, {}, &TraceEvent::startNs);
+    return events;
+}
+
+}  // namespace booking_service::replay
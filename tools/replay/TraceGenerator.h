@@ -0,0 +1,37 @@
+#pragma once
+#include "DataStore.h"
+#include "Trace.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace booking_service::replay {
+
+/**
+ * @brief Parameters of a synthetic workload.
+ *  - Background requests arrive as a Poisson process and pick screenings by Zipfian popularity.
+ *  - Flash sales add bursts of bookings on one popular screening within a short window.
+ */
+struct GeneratorOptions {
+    std::size_t events = 100000;          ///< Background requests.
+    double ratePerSecond = 10000;         ///< Mean arrival rate of background requests.
+    double zipfExponent = 1.0;            ///< Popularity skew; 0 means uniform.
+    double readRatio = 0.5;               ///< Share of background requests that only read seats.
+    int maxSeatsPerBooking = 4;           ///< Bookings ask for 1..max adjacent seats.
+    int bursts = 0;                       ///< Number of flash-sale bursts.
+    std::size_t burstSize = 10000;        ///< Bookings per burst.
+    std::chrono::milliseconds burstWindow{100};
+    std::uint64_t seed = 1;
+};
+
+/**
+ * @brief Generates a trace against the screenings of a loaded store, ordered by start time.
+ *
+ * Events address screenings by id and carry no recorded outcome.
+ * Throws std::invalid_argument if ratePerSecond is not a positive finite number, zipfExponent is
+ * negative or not finite, readRatio is outside [0, 1] or burstWindow is negative.
+ */
+std::vector<TraceEvent> GenerateTrace(const DataStore& store, const GeneratorOptions& options);
+
+}  // namespace booking_service::replay
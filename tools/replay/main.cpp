@@ -0,0 +1,133 @@
+#include "DataStore.h"
+#include "Replayer.h"
+#include "Trace.h"
+#include "TraceGenerator.h"
+
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+using namespace booking_service;
+using namespace booking_service::replay;
+
+namespace {
+
+constexpr std::string_view kUsage =
+    "Usage:\n"
+    "  booking_replay generate --out FILE [--data DIR] [--events N] [--rate PER_SEC] [--zipf S]\n"
+    "                          [--reads RATIO] [--max-seats N] [--bursts N] [--burst-size N]\n"
+    "                          [--burst-window-ms MS] [--seed N]\n"
+    "  booking_replay replay --trace FILE [--data DIR | --snapshot FILE] [--threads N]\n"
+    "                        [--pace original|max] [--order show|spread]\n";
+
+constexpr std::string_view kPathData = "data";
+
+/**
+ * Parses "--key value" pairs following the command.
+ */
+std::map<std::string, std::string> ParseFlags(int argc, char** argv) {
+    std::map<std::string, std::string> flags;
+    for (int i = 2; i < argc; ++i) {
+        const std::string key = argv[i];
+        if (!key.starts_with("--") || i + 1 >= argc) {
+            throw std::invalid_argument("Expected --flag value, got " + key);
+        }
+        flags[key.substr(2)] = argv[++i];
+    }
+    return flags;
+}
+
+std::string Flag(const std::map<std::string, std::string>& flags, const std::string& key, std::string_view fallback) {
+    auto it = flags.find(key);
+    return it != flags.end() ? it->second : std::string(fallback);
+}
+
+std::string RequiredFlag(const std::map<std::string, std::string>& flags, const std::string& key) {
+    auto it = flags.find(key);
+    if (it == flags.end()) {
+        throw std::invalid_argument("Missing --" + key);
+    }
+    return it->second;
+}
+
+int Generate(const std::map<std::string, std::string>& flags) {
+    GeneratorOptions options;
+    options.events = std::stoull(Flag(flags, "events", std::to_string(options.events)));
+    options.ratePerSecond = std::stod(Flag(flags, "rate", std::to_string(options.ratePerSecond)));
+    options.zipfExponent = std::stod(Flag(flags, "zipf", std::to_string(options.zipfExponent)));
+    options.readRatio = std::stod(Flag(flags, "reads", std::to_string(options.readRatio)));
+    options.maxSeatsPerBooking = std::stoi(Flag(flags, "max-seats", std::to_string(options.maxSeatsPerBooking)));
+    options.bursts = std::stoi(Flag(flags, "bursts", std::to_string(options.bursts)));
+    options.burstSize = std::stoull(Flag(flags, "burst-size", std::to_string(options.burstSize)));
+    const auto burstWindowMs = Flag(flags, "burst-window-ms", std::to_string(options.burstWindow.count()));
+    options.burstWindow = std::chrono::milliseconds{std::stoll(burstWindowMs)};
+    options.seed = std::stoull(Flag(flags, "seed", std::to_string(options.seed)));
+
+    DataStore store;
+    store.LoadData(Flag(flags, "data", kPathData));
+    const auto events = GenerateTrace(store, options);
+    SaveTrace(RequiredFlag(flags, "out"), events);
+    std::cout << "Generated " << events.size() << " events\n";
+    return 0;
+}
+
+int RunReplay(const std::map<std::string, std::string>& flags) {
+    const auto events = LoadTrace(RequiredFlag(flags, "trace"));
+
+    DataStore store;
+    if (flags.contains("snapshot")) {
+        store.ImportSnapshot(flags.at("snapshot"));
+    }
+    else {
+        store.LoadData(Flag(flags, "data", kPathData));
+    }
+
+    ReplayOptions options;
+    options.threads = std::stoi(Flag(flags, "threads", "1"));
+    const std::string pace = Flag(flags, "pace", "max");
+    if (pace != "original" && pace != "max") {
+        throw std::invalid_argument("Unknown pace: " + pace);
+    }
+    options.originalPace = pace == "original";
+    const std::string order = Flag(flags, "order", "show");
+    if (order != "show" && order != "spread") {
+        throw std::invalid_argument("Unknown order: " + order);
+    }
+    options.spreadShows = order == "spread";
+
+    const auto report = Replay(store, events, options);
+    PrintReport(std::cout, report);
+    return report.Verified() ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << kUsage;
+        return 2;
+    }
+
+    try {
+        const std::string command = argv[1];
+        const auto flags = ParseFlags(argc, argv);
+        if (command == "generate") {
+            return Generate(flags);
+        }
+        if (command == "replay") {
+            return RunReplay(flags);
+        }
+        std::cerr << kUsage;
+        return 2;
+    }
+    catch (const std::invalid_argument& e) {
+        // Bad flags or flag values, including numbers std::stoi/std::stod cannot parse
+        std::cerr << "Error: " << e.what() << "\n" << kUsage;
+        return 2;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}